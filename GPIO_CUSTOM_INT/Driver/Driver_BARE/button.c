@@ -22,12 +22,7 @@
   * @retval	None
   */
 void BTN_enable(btn_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DIR_REG);
-	uint32_t mask = BTN_ALL_MASK;
-
-	mask = mask | status;
-
-	APE_writeValue32(self->base_addr,APE_DIR_REG,mask);
+	APE_SHADOW_update(self->base_addr,APE_DIR_REG,BTN_ALL_MASK,0);
 }
 
 /**
@@ -36,12 +31,7 @@ void BTN_enable(btn_t* self){
   * @retval	None
   */
 void BTN_disable(btn_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DIR_REG);
-	uint32_t mask = ~BTN_ALL_MASK;
-
-	mask = mask & status;
-
-	APE_writeValue32(self->base_addr,APE_DIR_REG,mask);
+	APE_SHADOW_update(self->base_addr,APE_DIR_REG,0,BTN_ALL_MASK);
 }
 
 /**
@@ -50,7 +40,7 @@ void BTN_disable(btn_t* self){
   * @retval	il valore del nibble del registro dato su cui sono mappati i bottoni
   */
 uint32_t BTN_readStatus(btn_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DATA_REG);
+	uint32_t status = APE_READ32(self->base_addr,APE_DATA_REG);
 	status = (status & BTN_ALL_MASK);
 	return (status >> BTN_NIBBLE_OFFSET);
 }
@@ -67,28 +57,18 @@ uint32_t BTN_readStatus(btn_t* self){
   * @retval	None
   */
 void BTN_enableInterrupt(btn_t* self,uint32_t int_mask,interrupt_mode mode){
-	uint32_t status;
 	uint32_t mask = int_mask << BTN_NIBBLE_OFFSET;
 
 	switch (mode){
 	case INT_RISING:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,mask,0);
 		break;
 	case INT_FALLING:
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,mask,0);
 		break;
 	case INT_RIS_FALL:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
-
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,mask,0);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,mask,0);
 		break;
 	}
 }
@@ -105,29 +85,18 @@ void BTN_enableInterrupt(btn_t* self,uint32_t int_mask,interrupt_mode mode){
   * @retval	None
   */
 void BTN_disableInterrupt(btn_t* self,uint32_t int_mask,interrupt_mode mode){
-	uint32_t status;
 	uint32_t mask = int_mask << BTN_NIBBLE_OFFSET;
-	mask = ~mask;
 
 	switch (mode){
 	case INT_RISING:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,0,mask);
 		break;
 	case INT_FALLING:
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,0,mask);
 		break;
 	case INT_RIS_FALL:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
-
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,0,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,0,mask);
 		break;
 	}
 }
@@ -138,7 +107,7 @@ void BTN_disableInterrupt(btn_t* self,uint32_t int_mask,interrupt_mode mode){
   * @retval	il valore del nibble del registro ISR su cui sono mappate le interrupt dei bottoni
   */
 uint32_t BTN_readISR(btn_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_ICRISR_REG);
+	uint32_t status = APE_READ32(self->base_addr,APE_ICRISR_REG);
 	status = (status & BTN_ALL_MASK);
 	return (status >> BTN_NIBBLE_OFFSET);
 }
@@ -150,12 +119,34 @@ uint32_t BTN_readISR(btn_t* self){
   * @retval	None
   */
 void BTN_clearISR(btn_t* self,uint32_t int_mask){
-	uint32_t ISR_value = APE_readValue32(self->base_addr,APE_ICRISR_REG);
+	uint32_t ISR_value = APE_READ32(self->base_addr,APE_ICRISR_REG);
 	uint32_t mask = int_mask & (ISR_value >> BTN_NIBBLE_OFFSET);
 
 	mask = mask << BTN_NIBBLE_OFFSET;
 
-	APE_writeValue32(self->base_addr,APE_ICRISR_REG,mask);
+	APE_WRITE32(self->base_addr,APE_ICRISR_REG,mask);
+}
+
+/**
+  * @brief  estrae il valore dei bottoni da una fotografia della periferica
+  * @param 	self: puntatore alla struttura
+  * @param 	snap: fotografia acquisita con APE_SNAP_capture
+  * @retval	il valore del nibble del registro dato su cui sono mappati dei bottoni
+  */
+uint32_t BTN_decodeStatus(btn_t* self,const gpio_snapshot_t* snap){
+	(void)self;
+	return (snap->data & BTN_ALL_MASK) >> BTN_NIBBLE_OFFSET;
+}
+
+/**
+  * @brief  estrae le interrupt dei bottoni da una fotografia della periferica
+  * @param 	self: puntatore alla struttura
+  * @param 	snap: fotografia acquisita con APE_SNAP_captureAll
+  * @retval	il valore del nibble del registro ISR su cui sono mappate le interrupt dei bottoni
+  */
+uint32_t BTN_decodeISR(btn_t* self,const gpio_snapshot_t* snap){
+	(void)self;
+	return (snap->isr & BTN_ALL_MASK) >> BTN_NIBBLE_OFFSET;
 }
 
 /**
@@ -212,6 +203,8 @@ void BTN_Init(btn_t* self){
 	self->enable = &BTN_enable;
 	self->disable = &BTN_disable;
 	self->readStatus = &BTN_readStatus;
+	self->decodeStatus = &BTN_decodeStatus;
+	self->decodeISR = &BTN_decodeISR;
 	self->enableInterrupt = &BTN_enableInterrupt;
 	self->disableInterrupt = &BTN_disableInterrupt;
 	self->readISR = &BTN_readISR;
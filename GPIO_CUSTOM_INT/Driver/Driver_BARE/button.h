@@ -18,7 +18,9 @@
 #define SRC_BUTTON_H_
 
 /* Includes ------------------------------------------------------------------*/
-#include "gpio_LL.h"
+#include "gpio_LL_inline.h"
+#include "gpio_shadow.h"
+#include "gpio_snapshot.h"
 #include "defines.h"
 
 /* Macro ---------------------------------------------------------------------*/
@@ -57,6 +59,8 @@ struct btn_t{
 	void (*enable)(btn_t* self);
 	void (*disable)(btn_t* self);
 	uint32_t (*readStatus)(btn_t* self);
+	uint32_t (*decodeStatus)(btn_t* self,const gpio_snapshot_t* snap);
+	uint32_t (*decodeISR)(btn_t* self,const gpio_snapshot_t* snap);
 	void (*enableInterrupt)(btn_t*,uint32_t ,interrupt_mode);
 	void (*disableInterrupt)(btn_t*,uint32_t ,interrupt_mode);
 	uint32_t (*readISR)(btn_t*);
@@ -69,6 +73,15 @@ struct btn_t{
  */
 void BTN_Init(btn_t*);
 
+/**
+  * @brief firme delle callback, definite deboli nel modulo e invocate
+  * 		dalla tabella di dispatch predefinita di gpio_it.c
+ */
+void APE_BTN0_Callback(void);
+void APE_BTN1_Callback(void);
+void APE_BTN2_Callback(void);
+void APE_BTN3_Callback(void);
+
 #endif /* SRC_BUTTON_H_ */
 /**@}*/
 /**@}*/
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    debounce.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa il filtro antirimbalzo a contatori
+  * 		 verticali.
+  *
+  *	@addtogroup LIB_OBJECTS
+  * @{
+  * @addtogroup DEBOUNCE
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes -------------------------------------------------------------------*/
+#include "debounce.h"
+
+/**
+  * @brief  inizializza il filtro
+  * @param 	self: puntatore alla struttura
+  * @param 	mask: maschera dei pin da filtrare (es. BTN_ALL_MASK | SW_ALL_MASK)
+  * @param 	initial: valore iniziale del registro dato
+  * @retval	None
+  */
+void APE_DEB_Init(debounce_t* self,uint32_t mask,uint32_t initial){
+	self->mask = mask;
+	self->state = initial & mask;
+	self->cnt0 = 0;
+	self->cnt1 = 0;
+	self->rising = 0;
+	self->falling = 0;
+}
+
+/**
+  * @brief  elabora un campione del registro dato
+  * @param 	self: puntatore alla struttura
+  * @param 	raw: valore letto dal registro dato
+  * @retval	maschera dei pin che hanno cambiato stato filtrato
+  */
+uint32_t APE_DEB_sample(debounce_t* self,uint32_t raw){
+	uint32_t delta = (raw & self->mask) ^ self->state;
+	uint32_t changed = delta & self->cnt0 & self->cnt1;
+
+	/* Incrementa i contatori dei pin diversi dallo stato, azzera gli altri */
+	self->cnt1 = (self->cnt1 ^ self->cnt0) & delta;
+	self->cnt0 = ~self->cnt0 & delta;
+
+	/* I contatori arrivati a APE_DEB_SAMPLES sono tornati a zero */
+	self->state ^= changed;
+	self->rising = changed & self->state;
+	self->falling = changed & ~self->state;
+
+	return changed;
+}
+
+/**
+  * @brief  indica i pin in transizione, per i quali il filtro va ancora
+  * 		campionato
+  * @param 	self: puntatore alla struttura
+  * @retval	maschera dei pin con contatore diverso da zero
+  */
+uint32_t APE_DEB_busy(debounce_t* self){
+	return self->cnt0 | self->cnt1;
+}
+/**@}*/
+/**@}*/
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    debounce.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce il filtro antirimbalzo per i pin in
+  * 		 ingresso della periferica APE_GPIO.
+  *
+  *	@addtogroup LIB_OBJECTS
+  * @{
+  * @addtogroup DEBOUNCE
+  * @{
+  * @brief Questo modulo filtra i rimbalzi di bottoni e switch.
+  * @details Il filtro usa contatori verticali a 2 bit: il bit i-esimo di cnt0
+  * 		 e cnt1 forma il contatore del pin i, quindi tutti i 32 pin del
+  * 		 registro dato sono filtrati insieme con poche operazioni bit a bit
+  * 		 per campione, indipendentemente dal numero di pin monitorati.
+  * 		 Un pin cambia stato solo dopo APE_DEB_SAMPLES campioni consecutivi
+  * 		 diversi dallo stato filtrato; un campione uguale azzera il contatore.
+  * 		 Il filtro puo' essere alimentato:
+  * 		 - da un tick periodico, passando ad APE_DEB_sample il registro dato
+  * 		   (ad esempio da una fotografia gpio_snapshot_t);
+  * 		 - dalle interrupt: l'handler campiona il registro dato e il tick resta
+  * 		   attivo solo finche' APE_DEB_busy indica pin in transizione.
+  * 		 Le maschere rising e falling sono nelle posizioni del registro, quindi
+  * 		 possono essere passate direttamente ad APE_IT_dispatch (gpio_it.h)
+  * 		 per invocare le callback registrate:
+  * 		 @code
+  * 		 if(APE_DEB_sample(&deb,APE_SNAP_capture(&snap))){
+  * 		 	APE_IT_dispatch(&APE_IT_gpio0,deb.rising | deb.falling);
+  * 		 }
+  * 		 @endcode
+  ******************************************************************************
+  */
+#ifndef SRC_DEBOUNCE_H_
+#define SRC_DEBOUNCE_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_DEB_SAMPLES		4	/*!< campioni consecutivi necessari per un cambio di stato*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief stato del filtro antirimbalzo di una periferica
+  */
+typedef struct {
+	uint32_t mask;		/*!< pin filtrati*/
+	uint32_t state;		/*!< stato filtrato dei pin*/
+	uint32_t cnt0;		/*!< bit meno significativo dei contatori*/
+	uint32_t cnt1;		/*!< bit piu' significativo dei contatori*/
+	uint32_t rising;	/*!< pin passati a '1' all'ultimo campione*/
+	uint32_t falling;	/*!< pin passati a '0' all'ultimo campione*/
+} debounce_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+void APE_DEB_Init(debounce_t*,uint32_t,uint32_t);
+uint32_t APE_DEB_sample(debounce_t*,uint32_t);
+uint32_t APE_DEB_busy(debounce_t*);
+
+#endif /* SRC_DEBOUNCE_H_ */
+/**@}*/
+/**@}*/
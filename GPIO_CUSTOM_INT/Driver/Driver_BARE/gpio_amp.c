@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    gpio_amp.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa la configurazione AMP del driver
+  * 		 BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "gpio_amp.h"
+
+#ifdef DRIVER_BARE
+
+/* Private variables ---------------------------------------------------------*/
+static gpio_amp_shared_t* const APE_AMP_shared = (gpio_amp_shared_t*)APE_AMP_SHARED_ADDR;	/*!< area condivisa*/
+static XScuGic* APE_AMP_intc = NULL;	/*!< GIC usato per la SGI di risveglio*/
+
+/**
+  * @brief  handler della CPU1: serve la periferica con l'handler generico,
+  * 		che registra l'evento nella coda condivisa, e risveglia la CPU0
+  * @param  instance: puntatore alla gpio_it_t della periferica
+  * @retval None
+  */
+static void APE_AMP_IRQHandler(void* instance){
+	APE_IRQHandler(instance);
+	XScuGic_SoftwareIntr(APE_AMP_intc,APE_AMP_SGI_ID,XSCUGIC_SPI_CPU0_MASK);
+}
+
+/**
+  * @brief  handler della SGI sulla CPU0: non ha lavoro da svolgere, serve
+  * 		solo a terminare la WFI
+  * @param  context: non utilizzato
+  * @retval None
+  */
+static void APE_AMP_wakeHandler(void* context){
+	(void)context;
+}
+
+/**
+  * @brief  da chiamare sulla CPU1: inizializza le code condivise e collega
+  * 		le periferiche, dirigendone le interrupt verso la CPU1
+  * @param  intc: GIC gia' inizializzato
+  * @param  instances: vettore delle periferiche
+  * @param  count: numero di periferiche, al massimo APE_AMP_MAX_INSTANCES
+  * @retval XST_SUCCESS oppure XST_FAILURE
+  */
+int APE_AMP_serverInit(XScuGic* intc,const APE_IT_instance_t* instances,int count){
+	int i;
+
+	if(count > APE_AMP_MAX_INSTANCES){
+		return XST_FAILURE;
+	}
+	APE_AMP_intc = intc;
+
+	/* Ritira eventuali code di un'esecuzione precedente */
+	APE_AMP_shared->magic = 0;
+	APE_RING_CLEAN(&APE_AMP_shared->magic,APE_RING_CACHE_LINE);
+
+	for(i = 0; i < count; i++){
+		APE_RING_Init(&APE_AMP_shared->rings[i]);
+		APE_IT_setRing(instances[i].table,&APE_AMP_shared->rings[i]);
+	}
+
+	if(XST_SUCCESS != APE_IT_connectHandler(intc,instances,count,&APE_AMP_IRQHandler)){
+		return XST_FAILURE;
+	}
+	for(i = 0; i < count; i++){
+		XScuGic_InterruptUnmapCpu(intc,APE_AMP_CLIENT_CPU,instances[i].irq_id);
+		XScuGic_InterruptMaptoCpu(intc,APE_AMP_SERVER_CPU,instances[i].irq_id);
+	}
+
+	/* Pubblica le code alla CPU0 */
+	APE_AMP_shared->count = count;
+	APE_RING_BARRIER();
+	APE_AMP_shared->magic = APE_AMP_MAGIC;
+	APE_RING_CLEAN(&APE_AMP_shared->magic,APE_RING_CACHE_LINE);
+	return XST_SUCCESS;
+}
+
+/**
+  * @brief  da chiamare sulla CPU0: attende le code pubblicate dalla CPU1,
+  * 		le associa alle tabelle e abilita la SGI di risveglio
+  * @param  intc: GIC gia' inizializzato
+  * @param  tables: tabelle nello stesso ordine delle periferiche della CPU1
+  * @param  count: numero di tabelle
+  * @retval XST_SUCCESS, oppure XST_FAILURE se la CPU1 non ha pubblicato le
+  * 		code entro APE_AMP_WAIT_LOOPS tentativi
+  */
+int APE_AMP_clientInit(XScuGic* intc,gpio_it_t* const* tables,int count){
+	uint32_t loops = 0;
+	int i;
+
+	do{
+		APE_RING_INVALIDATE(&APE_AMP_shared->magic,APE_RING_CACHE_LINE);
+		if(++loops > APE_AMP_WAIT_LOOPS){
+			return XST_FAILURE;
+		}
+	}while(APE_AMP_shared->magic != APE_AMP_MAGIC);
+
+	if(count > (int)APE_AMP_shared->count){
+		return XST_FAILURE;
+	}
+	for(i = 0; i < count; i++){
+		APE_IT_setRing(tables[i],&APE_AMP_shared->rings[i]);
+	}
+
+	if(XST_SUCCESS != XScuGic_Connect(intc,APE_AMP_SGI_ID,(Xil_InterruptHandler)APE_AMP_wakeHandler,NULL)){
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(intc,APE_AMP_SGI_ID);
+	return XST_SUCCESS;
+}
+
+#endif /* DRIVER_BARE */
+/**@}*/
+/**@}*/
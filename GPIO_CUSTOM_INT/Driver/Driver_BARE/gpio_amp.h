@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    gpio_amp.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce la configurazione AMP del driver
+  * 		 BARE_METAL, con le interrupt della periferica servite dalla CPU1.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  * @brief   Configurazione AMP: la CPU1 serve le interrupt APE_GPIO, la CPU0
+  * 		 esegue le callback.
+  * @details Le due CPU eseguono due applicazioni distinte, compilate con
+  * 		 APE_RING_SHARED definita e, per la CPU1, con il BSP in modalita'
+  * 		 USE_AMP (il distributore del GIC e' inizializzato solo dalla CPU0).
+  * 		 - CPU1: APE_AMP_serverInit inizializza in memoria condivisa una coda
+  * 		   per ogni periferica, dirige le linee di interrupt verso la CPU1
+  * 		   tramite i registri target del GIC e collega un handler che esegue
+  * 		   APE_IRQHandler (che registra l'evento nella coda) e poi risveglia
+  * 		   la CPU0 con una interrupt software (SGI).
+  * 		 - CPU0: APE_AMP_clientInit attende che le code siano pronte, le
+  * 		   associa alle proprie tabelle gpio_it_t e collega la SGI; le callback
+  * 		   sono invocate da APE_IT_drain o dallo scheduler (scheduler.h), che
+  * 		   dorme in WFI fino alla SGI.
+  * 		 Le code risiedono all'indirizzo APE_AMP_SHARED_ADDR, che entrambi i
+  * 		 linker script devono escludere dalle proprie sezioni; la coerenza
+  * 		 delle cache e' garantita dalla manutenzione esplicita di gpio_ring.h.
+  * 		 @code
+  * 		 // CPU1
+  * 		 APE_AMP_serverInit(&Intc,gpio_instances,1);
+  * 		 // CPU0
+  * 		 gpio_it_t* tables[] = { &APE_IT_gpio0 };
+  * 		 APE_AMP_clientInit(&Intc,tables,1);
+  * 		 APE_SCHED_addSource(&APE_IT_gpio0);
+  * 		 @endcode
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_AMP_H_
+#define SRC_GPIO_AMP_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_it.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_AMP_SHARED_ADDR		0xFFFF0000	/*!< indirizzo delle code condivise (OCM mappata in alto)*/
+#define APE_AMP_MAX_INSTANCES	4			/*!< numero massimo di periferiche servite dalla CPU1*/
+#define APE_AMP_SERVER_CPU		1			/*!< CPU che serve le interrupt*/
+#define APE_AMP_CLIENT_CPU		0			/*!< CPU che esegue le callback*/
+#define APE_AMP_SGI_ID			15			/*!< interrupt software di risveglio della CPU0*/
+#define APE_AMP_MAGIC			0x41504541	/*!< "APEA": code inizializzate dalla CPU1*/
+#define APE_AMP_WAIT_LOOPS		10000000	/*!< tentativi di attesa della CPU1 da parte della CPU0*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief area di memoria condivisa tra le due CPU
+  */
+typedef struct {
+	volatile uint32_t magic __attribute__((aligned(APE_RING_CACHE_LINE)));	/*!< APE_AMP_MAGIC quando le code sono pronte*/
+	volatile uint32_t count;												/*!< numero di code inizializzate*/
+	gpio_ring_t rings[APE_AMP_MAX_INSTANCES];								/*!< una coda per periferica*/
+} gpio_amp_shared_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+#ifdef DRIVER_BARE
+int APE_AMP_serverInit(XScuGic*,const APE_IT_instance_t*,int);
+int APE_AMP_clientInit(XScuGic*,gpio_it_t* const*,int);
+#endif
+
+#endif /* SRC_GPIO_AMP_H_ */
+/**@}*/
+/**@}*/
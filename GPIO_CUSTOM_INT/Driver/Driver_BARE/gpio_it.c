@@ -7,8 +7,20 @@
   * @brief   Questo file implementa le Interrupt Handler della
   * 	     periferica APE_GPIO. Mediante le define nel file defines.h e' possibile
   *	     	specificare di quali moduli abilitare la gestione delle interrupt.
-  *		     E' presente anche un template per definire un' opportuna IRQ Handler
-  *			 nel caso vi siano eventuali modifiche dell'hardware.
+  *		     Le callback sono registrate a runtime in una tabella per periferica
+  *			 (gpio_it_t): l'handler scorre i soli bit pendenti di ISR, quindi
+  *			 il costo dipende dal numero di fronti e non dal numero di pin.
+  *			 Per una nuova periferica e' sufficiente dichiarare una gpio_it_t,
+  *			 inizializzarla con APE_IT_Init e aggiungerla al vettore di
+  *			 APE_IT_instance_t passato ad APE_IT_connect, che collega al GIC
+  *			 l'handler generico con la tabella come contesto e la priorita'
+  *			 indicata per ciascuna periferica.
+  *			 Associando una coda con APE_IT_setRing le callback sono differite:
+  *			 la IRQ Handler registra solo un evento {pending, data, timestamp}
+  *			 e il programma principale le invoca con APE_IT_drain, quindi una
+  *			 callback lenta non ritarda le altre interrupt.
+  *			 Con APE_PROFILE definita handler e callback sono cronometrati
+  *			 (gpio_profile.h).
   *	@addtogroup DRIVER
   * @{
   * @addtogroup BARE_METAL
@@ -18,7 +30,11 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
+#include <assert.h>
+#include <stddef.h>
 #include "gpio_it.h"
+#include "gpio_LL_inline.h"
+#include "gpio_profile.h"
 
 /**
   * @brief Se il modulo bottoni e' abilitato, include la rispettiva libreria.
@@ -35,69 +51,268 @@
 #endif /* MODULO SWITCH ABILITATO */
 
 /**
-  * @brief  IRQ Handler della periferica GPIO_0, chiama le
-  *	    callback di tutti i pin che hanno generato interrupt.
-  * @param  None
+  * @brief firma delle callback deboli di bottoni e switch
+  */
+typedef void (*APE_IT_legacy_t)(void);
+
+/**
+  * @brief  adatta una callback senza argomenti alla firma APE_IT_callback_t
+  * @param  context: puntatore alla callback da invocare
+  * @param  pin: posizione del pin (ignorata)
   * @retval None
   */
-void APE_IRQHandler_0(void){
+static void APE_IT_legacy(void* context,int pin){
+	(void)pin;
+	(*(const APE_IT_legacy_t*)context)();
+}
 
-	/* Legge il registro ISR */
-	uint32_t state = APE_readValue32((uint32_t*)GPIO_0_BASE_ADDRESS,APE_ICRISR_REG);
+#ifdef APE_BTN_MOD_ENABLED
+/**
+  * @brief callback deboli dei bottoni, in ordine di posizione
+  */
+static const APE_IT_legacy_t APE_IT_btnCallbacks[4] = {
+	&APE_BTN0_Callback, &APE_BTN1_Callback, &APE_BTN2_Callback, &APE_BTN3_Callback
+};
+#endif /* MODULO BOTTONI ABILITATO */
 
-	/* Azzera il registro ISR */
-	APE_writeValue32((uint32_t*)GPIO_0_BASE_ADDRESS,APE_ICRISR_REG,0xFFFFFFFF);
+#ifdef APE_SW_MOD_ENABLED
+/**
+  * @brief callback deboli degli switch, in ordine di posizione
+  */
+static const APE_IT_legacy_t APE_IT_swCallbacks[4] = {
+	&APE_SW0_Callback, &APE_SW1_Callback, &APE_SW2_Callback, &APE_SW3_Callback
+};
+#endif /* MODULO SWITCH ABILITATO */
 
-	/* Chiama le callback dei bottoni */
-	if((BTN0_MASK & state) == BTN0_MASK){
-		APE_BTN0_Callback();
-	}
-	if((BTN1_MASK & state) == BTN1_MASK){
-		APE_BTN1_Callback();
-	}
-	if((BTN2_MASK & state) == BTN2_MASK){
-		APE_BTN2_Callback();
+/**
+  * @brief tabella della periferica GPIO_0: bottoni e switch invocano le
+  * 		rispettive callback deboli, come nella versione precedente
+  * 		dell'handler
+  */
+gpio_it_t APE_IT_gpio0 = {
+	.base_addr = (uint32_t*)GPIO_0_BASE_ADDRESS,
+	.table = {
+#ifdef APE_BTN_MOD_ENABLED
+		[BTN0] = { &APE_IT_legacy, (void*)&APE_IT_btnCallbacks[0] },
+		[BTN1] = { &APE_IT_legacy, (void*)&APE_IT_btnCallbacks[1] },
+		[BTN2] = { &APE_IT_legacy, (void*)&APE_IT_btnCallbacks[2] },
+		[BTN3] = { &APE_IT_legacy, (void*)&APE_IT_btnCallbacks[3] },
+#endif /* MODULO BOTTONI ABILITATO */
+#ifdef APE_SW_MOD_ENABLED
+		[SW0] = { &APE_IT_legacy, (void*)&APE_IT_swCallbacks[0] },
+		[SW1] = { &APE_IT_legacy, (void*)&APE_IT_swCallbacks[1] },
+		[SW2] = { &APE_IT_legacy, (void*)&APE_IT_swCallbacks[2] },
+		[SW3] = { &APE_IT_legacy, (void*)&APE_IT_swCallbacks[3] },
+#endif /* MODULO SWITCH ABILITATO */
 	}
-	if((BTN3_MASK & state) == BTN3_MASK){
-		APE_BTN3_Callback();
+};
+
+/**
+  * @brief  inizializza una tabella di dispatch vuota
+  * @param  self: puntatore alla tabella
+  * @param  base_addr: indirizzo base della periferica
+  * @retval None
+  */
+void APE_IT_Init(gpio_it_t* self,uint32_t* base_addr){
+	int i;
+
+	self->base_addr = base_addr;
+	self->ring = NULL;
+	for(i = 0; i < APE_IT_MAX_PINS; i++){
+		self->table[i].callback = NULL;
+		self->table[i].context = NULL;
 	}
+}
+
+/**
+  * @brief  registra la callback di un pin, sostituendo quella presente
+  * @param  self: puntatore alla tabella
+  * @param  pin: posizione del pin, da 0 a APE_IT_MAX_PINS-1
+  * @param  callback: funzione da invocare
+  * @param  context: argomento passato alla funzione
+  * @retval None
+  */
+void APE_IT_register(gpio_it_t* self,int pin,APE_IT_callback_t callback,void* context){
+	assert(pin >= 0 && pin < APE_IT_MAX_PINS);
+	self->table[pin].callback = callback;
+	self->table[pin].context = context;
+}
 
-	/* Chiama le callback degli switch*/
-	if((SW0_MASK & state) == SW0_MASK){
-		APE_SW0_Callback();
+/**
+  * @brief  rimuove la callback di un pin
+  * @param  self: puntatore alla tabella
+  * @param  pin: posizione del pin, da 0 a APE_IT_MAX_PINS-1
+  * @retval None
+  */
+void APE_IT_unregister(gpio_it_t* self,int pin){
+	assert(pin >= 0 && pin < APE_IT_MAX_PINS);
+	self->table[pin].callback = NULL;
+	self->table[pin].context = NULL;
+}
+
+/**
+  * @brief  invoca le callback dei pin indicati da pending, in ordine di
+  * 		posizione. Ogni iterazione individua il bit meno significativo
+  * 		con count-trailing-zeros (clz sul bit isolato su ARM) e lo azzera.
+  * @param  self: puntatore alla tabella
+  * @param  pending: maschera dei pin da servire
+  * @retval None
+  */
+void APE_IT_dispatch(gpio_it_t* self,uint32_t pending){
+	while(pending != 0){
+		int pin = __builtin_ctz(pending);
+		APE_IT_entry_t* entry = &self->table[pin];
+
+		pending &= pending - 1;
+		if(entry->callback != NULL){
+			APE_PROF_CB_BEGIN();
+			entry->callback(entry->context,pin);
+			APE_PROF_CB_END(pin);
+		}
 	}
-	if((SW1_MASK & state) == SW1_MASK){
-		APE_SW1_Callback();
+}
+
+/**
+  * @brief  associa una coda di eventi alla tabella: da questo momento la IRQ
+  * 		Handler non invoca le callback ma registra gli eventi
+  * @param  self: puntatore alla tabella
+  * @param  ring: coda inizializzata con APE_RING_Init, NULL per tornare
+  * 		alle callback nella IRQ Handler
+  * @retval None
+  */
+void APE_IT_setRing(gpio_it_t* self,gpio_ring_t* ring){
+	self->ring = ring;
+}
+
+/**
+  * @brief  estrae gli eventi registrati dalla IRQ Handler e invoca le
+  * 		callback dei pin pendenti, da chiamare nel programma principale.
+  * 		Durante la callback l'evento e' disponibile in self->event.
+  * @param  self: puntatore alla tabella
+  * @retval numero di eventi serviti
+  */
+int APE_IT_drain(gpio_it_t* self){
+	int served = 0;
+
+	if(self->ring == NULL){
+		return 0;
 	}
-	if((SW2_MASK & state) == SW2_MASK){
-		APE_SW2_Callback();
+	while(APE_RING_pop(self->ring,&self->event)){
+		APE_IT_dispatch(self,self->event.pending);
+		served++;
 	}
-	if((SW3_MASK & state) == SW3_MASK){
-		APE_SW3_Callback();
+	return served;
+}
+
+/**
+  * @brief  IRQ Handler generica: legge ISR, azzera i soli bit letti (un
+  * 		fronte arrivato dopo la lettura resta pendente e rialza gpio_int)
+  * 		e invoca le callback registrate, oppure registra l'evento nella
+  * 		coda se presente.
+  * @note   Firma compatibile con Xil_ExceptionHandler, la tabella va passata
+  * 		come CallBackRef a XScuGic_Connect.
+  * @param  instance: puntatore alla gpio_it_t della periferica
+  * @retval None
+  */
+void APE_IRQHandler(void* instance){
+	gpio_it_t* self = instance;
+	APE_PROF_ISR_ENTRY();
+
+	/* Legge il registro ISR */
+	uint32_t pending = APE_READ32(self->base_addr,APE_ICRISR_REG);
+
+	/* Azzera i bit pendenti letti */
+	APE_WRITE32(self->base_addr,APE_ICRISR_REG,pending);
+
+	/* Con la coda registra l'evento, le callback sono invocate da APE_IT_drain */
+	if(self->ring != NULL){
+		gpio_event_t event;
+
+		event.pending = pending;
+		event.data = APE_READ32(self->base_addr,APE_DATA_REG);
+		event.timestamp = APE_RING_timestamp();
+		APE_PROF_ISR_DISPATCH();
+		APE_RING_push(self->ring,&event);
+		APE_PROF_ISR_EXIT();
+		return;
 	}
 
-	/* ----------------------------- */
+	/* Chiama le callback dei soli pin pendenti */
+	self->event.pending = pending;
+	APE_PROF_ISR_DISPATCH();
+	APE_IT_dispatch(self,pending);
+	APE_PROF_ISR_EXIT();
 }
 
+#ifdef DRIVER_BARE
 /**
-  * @brief  IRQ Handler della periferica GPIO_X
-  * @note   Sostituire X con il numero della GPIO
-  * @param  None
-  * @retval None
+  * @brief  collega al GIC l'handler generico di ciascuna periferica di una
+  * 		tabella, con la priorita' e la sensibilita' indicate, e abilita le
+  * 		rispettive linee di interrupt
+  * @param  intc: GIC gia' inizializzato
+  * @param  instances: vettore delle periferiche
+  * @param  count: numero di periferiche
+  * @retval XST_SUCCESS, oppure XST_FAILURE se un collegamento fallisce (le
+  * 		periferiche gia' collegate vengono scollegate)
   */
-/*
-void APE_IRQHandler_X(void){
+int APE_IT_connect(XScuGic* intc,const APE_IT_instance_t* instances,int count){
+	return APE_IT_connectHandler(intc,instances,count,&APE_IRQHandler);
+}
 
-	//Legge il registro ISR
-	APE_readValue32();
+/**
+  * @brief  come APE_IT_connect, ma collega un handler diverso da quello
+  * 		generico (es. un wrapper che chiama APE_IRQHandler)
+  * @param  intc: GIC gia' inizializzato
+  * @param  instances: vettore delle periferiche
+  * @param  count: numero di periferiche
+  * @param  handler: funzione collegata, riceve la tabella come contesto
+  * @retval XST_SUCCESS oppure XST_FAILURE
+  */
+int APE_IT_connectHandler(XScuGic* intc,const APE_IT_instance_t* instances,int count,void (*handler)(void*)){
+	const APE_IT_instance_t* inst;
+	int i;
 
-	//Inserire qui il codice utente
+	for(i = 0; i < count; i++){
+		inst = &instances[i];
+		if(inst->base_addr != NULL){
+			inst->table->base_addr = inst->base_addr;
+		}
 
-	//-----------------------------
+		XScuGic_SetPriorityTriggerType(intc,inst->irq_id,inst->priority,inst->trigger);
+		if(XST_SUCCESS != XScuGic_Connect(intc,inst->irq_id,(Xil_InterruptHandler)handler,inst->table)){
+			APE_IT_disconnect(intc,instances,i);
+			return XST_FAILURE;
+		}
+		XScuGic_Enable(intc,inst->irq_id);
+	}
+	return XST_SUCCESS;
+}
 
-	// Azzera il registro ISR
-	APE_writeValue32();
+/**
+  * @brief  disabilita e scollega dal GIC le periferiche di una tabella
+  * @param  intc: GIC
+  * @param  instances: vettore delle periferiche
+  * @param  count: numero di periferiche
+  * @retval None
+  */
+void APE_IT_disconnect(XScuGic* intc,const APE_IT_instance_t* instances,int count){
+	int i;
+
+	for(i = 0; i < count; i++){
+		XScuGic_Disable(intc,instances[i].irq_id);
+		XScuGic_Disconnect(intc,instances[i].irq_id);
+	}
 }
-*/
+#endif /* DRIVER_BARE */
+
+/**
+  * @brief  IRQ Handler della periferica GPIO_0, chiama le
+  *	    callback di tutti i pin che hanno generato interrupt.
+  * @param  None
+  * @retval None
+  */
+void APE_IRQHandler_0(void){
+	APE_IRQHandler(&APE_IT_gpio0);
+}
+/**@}*/
 /**@}*/
-/**@}*/
\ No newline at end of file
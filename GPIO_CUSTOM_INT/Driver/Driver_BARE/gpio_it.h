@@ -19,13 +19,73 @@
 
 /* Include -------------------------------------------------------------------*/
 #include "defines.h"
+#include "gpio_LL.h"
+#include "gpio_ring.h"
+
+#ifdef DRIVER_BARE
+	#include "xscugic.h"
+#endif
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_IT_MAX_PINS		32		/*!< numero massimo di pin di una periferica*/
+#define APE_IT_TRIGGER_LEVEL	0x1		/*!< sensibilita' al livello alto della linea di interrupt*/
+#define APE_IT_TRIGGER_RISING	0x3		/*!< sensibilita' al fronte di salita della linea di interrupt*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief callback associata ad un pin: riceve il contesto registrato e
+  * 		la posizione del pin che ha generato l'interrupt
+  */
+typedef void (*APE_IT_callback_t)(void* context,int pin);
+
+/**
+  * @brief elemento della tabella di dispatch
+  */
+typedef struct {
+	APE_IT_callback_t callback;	/*!< funzione da invocare, NULL se assente*/
+	void* context;				/*!< argomento passato alla funzione*/
+} APE_IT_entry_t;
+
+/**
+  * @brief tabella di dispatch di una periferica APE_GPIO
+  */
+typedef struct {
+	uint32_t* base_addr;					/*!< indirizzo base della periferica*/
+	APE_IT_entry_t table[APE_IT_MAX_PINS];	/*!< callback indicizzate per posizione del pin*/
+	gpio_ring_t* ring;						/*!< coda degli eventi differiti, NULL se le callback sono invocate nella IRQ Handler*/
+	gpio_event_t event;						/*!< evento in corso di dispatch, consultabile dalle callback*/
+} gpio_it_t;
+
+/**
+  * @brief descrizione di una periferica APE_GPIO da collegare al GIC
+  */
+typedef struct {
+	gpio_it_t* table;		/*!< tabella di dispatch, passata come contesto all'handler*/
+	uint32_t* base_addr;	/*!< indirizzo base, NULL per mantenere quello della tabella*/
+	uint32_t irq_id;		/*!< ID della linea di interrupt nel GIC*/
+	uint8_t priority;		/*!< priorita' nel GIC (0 massima, multipli di 8)*/
+	uint8_t trigger;		/*!< sensibilita' (APE_IT_TRIGGER_LEVEL, APE_IT_TRIGGER_RISING)*/
+} APE_IT_instance_t;
+
+/* Variabili -----------------------------------------------------------------*/
+extern gpio_it_t APE_IT_gpio0;	/*!< tabella della periferica GPIO_0, preimpostata con le callback deboli*/
 
 /* Prototipi delle funzioni --------------------------------------------------*/
+void APE_IT_Init(gpio_it_t*,uint32_t*);
+void APE_IT_register(gpio_it_t*,int,APE_IT_callback_t,void*);
+void APE_IT_unregister(gpio_it_t*,int);
+void APE_IT_dispatch(gpio_it_t*,uint32_t);
+void APE_IT_setRing(gpio_it_t*,gpio_ring_t*);
+int APE_IT_drain(gpio_it_t*);
+void APE_IRQHandler(void*);
 void APE_IRQHandler_0(void);
-
-/* Template prototipo --------------------------------------------------------*/
-/*void APE_IRQHandler_X(void);*/
+#ifdef DRIVER_BARE
+int APE_IT_connect(XScuGic*,const APE_IT_instance_t*,int);
+int APE_IT_connectHandler(XScuGic*,const APE_IT_instance_t*,int,void (*)(void*));
+void APE_IT_disconnect(XScuGic*,const APE_IT_instance_t*,int);
+#endif
 
 #endif /* SRC_GPIO_IT_H_ */
 /**@}*/
-/**@}*/
\ No newline at end of file
+/**@}*/
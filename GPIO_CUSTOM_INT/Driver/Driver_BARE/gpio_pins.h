@@ -0,0 +1,202 @@
+/**
+  ******************************************************************************
+  * @file    gpio_pins.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce i generatori di banchi a dispatch statico
+  *
+  *	@addtogroup LIB_OBJECTS
+  * @{
+  * @addtogroup GPIO_PINS
+  * @{
+  * @brief Questo modulo fornisce un'alternativa a dispatch statico ai tipi
+  * 	   btn_t, led_t e switch_t.
+  * @details Le macro APE_DEFINE_OUTPUT_BANK e APE_DEFINE_INPUT_BANK generano
+  * 		 funzioni static inline specializzate su indirizzo base e nibble del
+  * 		 banco: non ci sono puntatori a funzione e le maschere sono costanti,
+  * 		 quindi ad esempio LED_BANK_toggle(LED0) si riduce a una lettura e
+  * 		 una scrittura del registro dato.
+  * 		 Nel driver BARE_METAL (e SIM) sono gia' istanziati i banchi LED_BANK,
+  * 		 BTN_BANK e SW_BANK sugli indirizzi di defines.h. Nel driver UIO
+  * 		 l'indirizzo base e' noto solo dopo la mmap, pertanto il banco va
+  * 		 generato passando come base la variabile che contiene il puntatore:
+  * 		 @code
+  * 		 uint32_t* gpio_base;
+  * 		 APE_DEFINE_OUTPUT_BANK(UIO_LED,gpio_base,LED_NIBBLE_OFFSET)
+  * 		 @endcode
+  * 		 Le macro APE_PINSET_* operano invece su insiemi di pin, espressi come OR
+  * 		 delle maschere BTNx_MASK, LEDx_MASK e SWx_MASK, di una stessa periferica:
+  * 		 qualunque combinazione di accensioni, spegnimenti, toggle e letture
+  * 		 costa al piu' una lettura e una scrittura del registro dato. Una scrittura
+  * 		 che coinvolge pin in ingresso e' rifiutata a tempo di compilazione.
+  * 		 @code
+  * 		 // accende LED0 e LED2 e legge BTN1: una lettura e una scrittura
+  * 		 uint32_t btn = APE_PINSET_UPDATE(GPIO_0_BASE_ADDRESS,LED0_MASK|LED2_MASK,0,BTN1_MASK);
+  * 		 @endcode
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_PINS_H_
+#define SRC_GPIO_PINS_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_LL_inline.h"
+#include "defines.h"
+
+#ifdef APE_BTN_MOD_ENABLED
+	#include "button.h"
+#endif /* MODULO BOTTONI ABILITATO */
+
+#ifdef APE_LED_MOD_ENABLED
+	#include "led.h"
+#endif /* MODULO LED ABILITATO */
+
+#ifdef APE_SW_MOD_ENABLED
+	#include "switch.h"
+#endif /* MODULO SWITCH ABILITATO */
+
+/* Macro ---------------------------------------------------------------------*/
+
+/**
+  * @brief genera le funzioni di un banco di 4 pin in uscita
+  * @param name: prefisso delle funzioni generate
+  * @param base: indirizzo base della periferica (costante o variabile)
+  * @param nibble: spiazzamento in bit del nibble del banco
+  */
+#define APE_DEFINE_OUTPUT_BANK(name,base,nibble)											\
+	/** @brief accende il pin in posizione pos */											\
+	static inline void name##_setOn(int pos){												\
+		APE_SET32((uint32_t*)(base),APE_DATA_REG,0x1u << pos);								\
+	}																						\
+	/** @brief spegne il pin in posizione pos */											\
+	static inline void name##_setOff(int pos){												\
+		APE_CLEAR32((uint32_t*)(base),APE_DATA_REG,0x1u << pos);							\
+	}																						\
+	/** @brief effettua il toggle del pin in posizione pos */								\
+	static inline void name##_toggle(int pos){												\
+		APE_TOGGLE32((uint32_t*)(base),APE_DATA_REG,0x1u << pos);							\
+	}																						\
+	/** @brief scrive il nibble del banco con una store a 8 bit */							\
+	static inline void name##_setLeds(uint32_t mask){										\
+		APE_WRITE8((uint32_t*)(base),APE_DATA_REG,											\
+				(uint8_t)((mask & 0xF) << ((nibble) % 8)),(nibble) / 8);					\
+	}																						\
+	/** @brief legge il nibble del banco */													\
+	static inline uint32_t name##_readStatus(void){											\
+		return (APE_READ32((uint32_t*)(base),APE_DATA_REG) >> (nibble)) & 0xF;				\
+	}
+
+/**
+  * @brief genera le funzioni di un banco di 4 pin in ingresso
+  * @param name: prefisso delle funzioni generate
+  * @param base: indirizzo base della periferica (costante o variabile)
+  * @param nibble: spiazzamento in bit del nibble del banco
+  */
+#define APE_DEFINE_INPUT_BANK(name,base,nibble)												\
+	/** @brief legge il nibble del banco */													\
+	static inline uint32_t name##_readStatus(void){											\
+		return (APE_READ32((uint32_t*)(base),APE_DATA_REG) >> (nibble)) & 0xF;				\
+	}																						\
+	/** @brief legge il pin in posizione pos */												\
+	static inline uint32_t name##_readPin(int pos){											\
+		return (APE_READ32((uint32_t*)(base),APE_DATA_REG) >> pos) & 0x1;					\
+	}																						\
+	/** @brief legge il nibble del banco nel registro ISR */								\
+	static inline uint32_t name##_readISR(void){											\
+		return (APE_READ32((uint32_t*)(base),APE_ICRISR_REG) >> (nibble)) & 0xF;			\
+	}																						\
+	/** @brief azzera le interrupt del banco indicate da int_mask (scrittura su ICR) */		\
+	static inline void name##_clearISR(uint32_t int_mask){									\
+		APE_WRITE32((uint32_t*)(base),APE_ICRISR_REG,(int_mask & 0xF) << (nibble));			\
+	}
+
+/**
+  * @brief pin configurati in ingresso secondo la mappatura di defines.h
+  */
+#if defined(APE_BTN_MOD_ENABLED) && defined(APE_SW_MOD_ENABLED)
+	#define APE_INPUT_PINS	(BTN_ALL_MASK | SW_ALL_MASK)
+#elif defined(APE_BTN_MOD_ENABLED)
+	#define APE_INPUT_PINS	BTN_ALL_MASK
+#elif defined(APE_SW_MOD_ENABLED)
+	#define APE_INPUT_PINS	SW_ALL_MASK
+#else
+	#define APE_INPUT_PINS	0x0
+#endif
+
+/**
+  * @brief verifica a tempo di compilazione che un insieme di pin da scrivere
+  * 		non contenga pin in ingresso
+  */
+#define APE_PINSET_CHECK_OUTPUT(pins)	APE_STATIC_CHECK(((pins) & APE_INPUT_PINS) == 0)
+
+/**
+  * @brief accende i pin di set e spegne quelli di clear con un'unica
+  * 		lettura e al piu' un'unica scrittura del registro dato
+  */
+#define APE_PINSET_WRITE(base,set,clear)											\
+	(APE_PINSET_CHECK_OUTPUT((set) | (clear)), APE_STATIC_CHECK(((set) & (clear)) == 0),	\
+	 (void)APE_pinsetUpdate((uint32_t*)(base),(set),(clear),0))
+
+/**
+  * @brief effettua il toggle dei pin di pins con un'unica lettura e scrittura
+  */
+#define APE_PINSET_TOGGLE(base,pins)												\
+	(APE_PINSET_CHECK_OUTPUT(pins), (void)APE_pinsetUpdate((uint32_t*)(base),0,0,(pins)))
+
+/**
+  * @brief legge i pin di pins con un'unica lettura, restituisce i bit nelle
+  * 		posizioni del registro
+  */
+#define APE_PINSET_READ(base,pins)													\
+	(APE_READ32((uint32_t*)(base),APE_DATA_REG) & (pins))
+
+/**
+  * @brief accende i pin di set, spegne quelli di clear e legge quelli di
+  * 		read_pins: la lettura necessaria all'aggiornamento fornisce anche
+  * 		il valore degli ingressi
+  */
+#define APE_PINSET_UPDATE(base,set,clear,read_pins)									\
+	(APE_PINSET_CHECK_OUTPUT((set) | (clear)), APE_STATIC_CHECK(((set) & (clear)) == 0),	\
+	 APE_pinsetUpdate((uint32_t*)(base),(set),(clear),0) & (read_pins))
+
+/* Funzioni inline -----------------------------------------------------------*/
+
+/**
+  * @brief  aggiorna il registro dato con un'unica lettura e, solo se il
+  * 		valore cambia, un'unica scrittura
+  * @param 	base: indirizzo base della periferica
+  * @param 	set: pin da accendere
+  * @param 	clear: pin da spegnere
+  * @param 	toggle: pin da invertire
+  * @retval il valore del registro dato letto prima dell'aggiornamento
+  */
+static inline uint32_t APE_pinsetUpdate(uint32_t* base,uint32_t set,uint32_t clear,uint32_t toggle){
+	uint32_t data = APE_READ32(base,APE_DATA_REG);
+	uint32_t next = ((data & ~clear) | set) ^ toggle;
+
+	if(next != data){
+		APE_WRITE32(base,APE_DATA_REG,next);
+	}
+	return data;
+}
+
+/* Banchi predefiniti --------------------------------------------------------*/
+#ifndef DRIVER_UIO
+
+#ifdef APE_LED_MOD_ENABLED
+	APE_DEFINE_OUTPUT_BANK(LED_BANK,LED_BASE_ADDRESS,LED_NIBBLE_OFFSET)
+#endif /* MODULO LED ABILITATO */
+
+#ifdef APE_BTN_MOD_ENABLED
+	APE_DEFINE_INPUT_BANK(BTN_BANK,BTN_BASE_ADDRESS,BTN_NIBBLE_OFFSET)
+#endif /* MODULO BOTTONI ABILITATO */
+
+#ifdef APE_SW_MOD_ENABLED
+	APE_DEFINE_INPUT_BANK(SW_BANK,SW_BASE_ADDRESS,SW_NIBBLE_OFFSET)
+#endif /* MODULO SWITCH ABILITATO */
+
+#endif /* DRIVER_UIO */
+
+#endif /* SRC_GPIO_PINS_H_ */
+/**@}*/
+/**@}*/
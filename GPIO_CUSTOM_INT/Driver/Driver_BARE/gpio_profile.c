@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file    gpio_profile.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa la profilazione della IRQ Handler e delle
+  * 		 callback del driver BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_profile.h"
+
+#if defined(APE_PROFILE) && defined(DRIVER_BARE)
+
+#include "xil_printf.h"
+
+/* Variabili -----------------------------------------------------------------*/
+gpio_prof_table_t APE_PROF_table;	/*!< misure accumulate*/
+
+/**
+  * @brief  converte una durata in nanosecondi
+  * @param  ticks: durata in tick del global timer
+  * @retval durata in nanosecondi
+  */
+static uint32_t APE_PROF_ns(uint32_t ticks){
+	return (uint32_t)(((uint64_t)ticks * 1000000000ULL) / COUNTS_PER_SECOND);
+}
+
+/**
+  * @brief  azzera le statistiche di una sezione
+  * @param  self: puntatore alla sezione
+  * @retval None
+  */
+static void APE_PROF_clear(gpio_prof_entry_t* self){
+	int i;
+
+	self->count = 0;
+	self->min = 0;
+	self->max = 0;
+	self->total = 0;
+	for(i = 0; i < APE_PROF_BUCKETS; i++){
+		self->hist[i] = 0;
+	}
+}
+
+/**
+  * @brief  stampa le statistiche di una sezione, se ha campioni
+  * @param  name: nome della sezione
+  * @param  pin: pin della callback, -1 per le sezioni della IRQ Handler
+  * @param  self: puntatore alla sezione
+  * @retval None
+  */
+static void APE_PROF_print(const char* name,int pin,const gpio_prof_entry_t* self){
+	int i;
+
+	if(self->count == 0){
+		return;
+	}
+	if(pin < 0){
+		xil_printf("%s",name);
+	}else{
+		xil_printf("%s%d",name,pin);
+	}
+	xil_printf("\tn=%d min=%dns avg=%dns max=%dns\t|",
+			(int)self->count,
+			(int)APE_PROF_ns(self->min),
+			(int)APE_PROF_ns((uint32_t)(self->total / self->count)),
+			(int)APE_PROF_ns(self->max));
+	for(i = 0; i < APE_PROF_BUCKETS; i++){
+		xil_printf(" %d",(int)self->hist[i]);
+	}
+	xil_printf("\r\n");
+}
+
+/**
+  * @brief  aggiunge un campione a una sezione
+  * @param  self: puntatore alla sezione
+  * @param  ticks: durata in tick del global timer
+  * @retval None
+  */
+void APE_PROF_record(gpio_prof_entry_t* self,uint32_t ticks){
+	int bucket = (31 - __builtin_clz(ticks | 1)) - APE_PROF_HIST_SHIFT;
+
+	if(bucket < 0){
+		bucket = 0;
+	}else if(bucket >= APE_PROF_BUCKETS){
+		bucket = APE_PROF_BUCKETS - 1;
+	}
+
+	if(self->count == 0 || ticks < self->min){
+		self->min = ticks;
+	}
+	if(ticks > self->max){
+		self->max = ticks;
+	}
+	self->count++;
+	self->total += ticks;
+	self->hist[bucket]++;
+}
+
+/**
+  * @brief  azzera tutte le misure
+  * @retval None
+  */
+void APE_PROF_reset(void){
+	int i;
+
+	APE_PROF_clear(&APE_PROF_table.isr);
+	APE_PROF_clear(&APE_PROF_table.entry);
+	for(i = 0; i < APE_PROF_MAX_PINS; i++){
+		APE_PROF_clear(&APE_PROF_table.pins[i]);
+	}
+}
+
+/**
+  * @brief  stampa le misure con xil_printf; le colonne dell'istogramma
+  * 		contano le durate inferiori a 2^(APE_PROF_HIST_SHIFT+1) tick, poi
+  * 		una colonna per ogni potenza di due, e l'ultima le restanti
+  * @retval None
+  */
+void APE_PROF_dump(void){
+	int i;
+
+	xil_printf("APE_PROF: 1 tick = 1/%d s\r\n",(int)COUNTS_PER_SECOND);
+	APE_PROF_print("isr",-1,&APE_PROF_table.isr);
+	APE_PROF_print("entry",-1,&APE_PROF_table.entry);
+	for(i = 0; i < APE_PROF_MAX_PINS; i++){
+		APE_PROF_print("pin",i,&APE_PROF_table.pins[i]);
+	}
+}
+
+#endif /* APE_PROFILE && DRIVER_BARE */
+/**@}*/
+/**@}*/
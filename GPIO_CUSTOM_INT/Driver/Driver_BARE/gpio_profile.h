@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file    gpio_profile.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce la profilazione della IRQ Handler e delle
+  * 		 callback del driver BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  * @brief   Profilazione opzionale, attiva solo se e' definita APE_PROFILE.
+  * @details Le macro APE_PROF_* leggono la parola bassa del global timer del
+  * 		 Cortex-A9 (COUNTS_PER_SECOND, meta' della frequenza della CPU) e
+  * 		 accumulano, in una tabella di dimensione fissa, numero di campioni,
+  * 		 minimo, massimo, somma e istogramma a potenze di due di:
+  * 		 - IRQ Handler dall'ingresso all'uscita;
+  * 		 - IRQ Handler dall'ingresso all'inizio del dispatch (lettura e
+  * 		   azzeramento di ISR);
+  * 		 - ciascuna callback, indicizzata per pin.
+  * 		 APE_PROF_dump stampa la tabella con xil_printf. Senza APE_PROFILE
+  * 		 le macro si espandono a nulla e il modulo non contiene codice.
+  * 		 Le misure sono aggiornate anche in interrupt: dump e reset vanno
+  * 		 chiamati dal programma principale e i valori letti durante una
+  * 		 interrupt possono essere parziali.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_PROFILE_H_
+#define SRC_GPIO_PROFILE_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "defines.h"
+
+#if defined(APE_PROFILE) && defined(DRIVER_BARE)
+
+#include "xtime_l.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_PROF_MAX_PINS		32	/*!< callback profilate, una per pin*/
+#define APE_PROF_BUCKETS		8	/*!< classi dell'istogramma*/
+#define APE_PROF_HIST_SHIFT		5	/*!< la classe 0 contiene le durate inferiori a 2^(SHIFT+1) tick*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief statistiche di una sezione misurata, in tick del global timer
+  */
+typedef struct {
+	uint32_t count;						/*!< campioni*/
+	uint32_t min;						/*!< durata minima*/
+	uint32_t max;						/*!< durata massima*/
+	uint64_t total;						/*!< somma delle durate*/
+	uint32_t hist[APE_PROF_BUCKETS];	/*!< campioni per classe di durata*/
+} gpio_prof_entry_t;
+
+/**
+  * @brief tabella delle misure
+  */
+typedef struct {
+	gpio_prof_entry_t isr;							/*!< IRQ Handler, dall'ingresso all'uscita*/
+	gpio_prof_entry_t entry;						/*!< IRQ Handler, dall'ingresso al dispatch*/
+	gpio_prof_entry_t pins[APE_PROF_MAX_PINS];		/*!< callback di ciascun pin*/
+} gpio_prof_table_t;
+
+extern gpio_prof_table_t APE_PROF_table;
+
+/* Funzioni inline -----------------------------------------------------------*/
+
+/**
+  * @brief  legge la parola bassa del global timer (una sola lettura, le
+  * 		differenze modulo 2^32 sono corrette fino a circa 12 s)
+  * @retval tick correnti
+  */
+static inline uint32_t APE_PROF_now(void){
+	return *(volatile uint32_t*)(GLOBAL_TMR_BASEADDR + GTIMER_COUNTER_LOWER_OFFSET);
+}
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+void APE_PROF_record(gpio_prof_entry_t*,uint32_t);
+void APE_PROF_reset(void);
+void APE_PROF_dump(void);
+
+/**
+  * @brief punti di misura, da usare nello stesso blocco: ENTRY dichiara
+  * 		l'istante di ingresso usato da DISPATCH ed EXIT, CB_BEGIN quello
+  * 		usato da CB_END
+  */
+#define APE_PROF_ISR_ENTRY()		uint32_t APE_PROF_t0 = APE_PROF_now()
+#define APE_PROF_ISR_DISPATCH()		APE_PROF_record(&APE_PROF_table.entry,APE_PROF_now() - APE_PROF_t0)
+#define APE_PROF_ISR_EXIT()			APE_PROF_record(&APE_PROF_table.isr,APE_PROF_now() - APE_PROF_t0)
+#define APE_PROF_CB_BEGIN()			uint32_t APE_PROF_t1 = APE_PROF_now()
+#define APE_PROF_CB_END(pin)		APE_PROF_record(&APE_PROF_table.pins[pin],APE_PROF_now() - APE_PROF_t1)
+
+#else
+
+#define APE_PROF_ISR_ENTRY()		((void)0)
+#define APE_PROF_ISR_DISPATCH()		((void)0)
+#define APE_PROF_ISR_EXIT()			((void)0)
+#define APE_PROF_CB_BEGIN()			((void)0)
+#define APE_PROF_CB_END(pin)		((void)0)
+
+#endif /* APE_PROFILE && DRIVER_BARE */
+
+#endif /* SRC_GPIO_PROFILE_H_ */
+/**@}*/
+/**@}*/
@@ -0,0 +1,176 @@
+/**
+  ******************************************************************************
+  * @file    gpio_ring.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce la coda di eventi tra la IRQ Handler e il
+  * 		 programma principale del driver BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  * @brief   Coda circolare lock-free a singolo produttore e singolo consumatore.
+  * @details La IRQ Handler (produttore) scrive solo head, il programma
+  * 		 principale (consumatore) scrive solo tail, quindi non servono
+  * 		 sezioni critiche ne' interrupt disabilitate: una barriera di memoria
+  * 		 garantisce che l'evento sia visibile prima dell'indice che lo pubblica.
+  * 		 Gli indici sono contatori liberi a 32 bit, la posizione nel buffer si
+  * 		 ottiene mascherandoli, pertanto APE_RING_SIZE deve essere una potenza
+  * 		 di due. Se la coda e' piena l'evento e' scartato e conteggiato in dropped.
+  * 		 Definendo APE_RING_SHARED la coda puo' collegare due CPU che non
+  * 		 condividono la cache dati (configurazione AMP, vedi gpio_amp.h): ogni
+  * 		 scrittura di un evento o di un indice e' seguita da un clean della linea
+  * 		 di cache e ogni lettura dell'indice o dell'evento dell'altra CPU e'
+  * 		 preceduta da un invalidate. head e tail occupano linee di cache distinte,
+  * 		 quindi ciascuna CPU scrive solo linee di cui e' l'unica proprietaria.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_RING_H_
+#define SRC_GPIO_RING_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_LL.h"
+
+#ifdef DRIVER_BARE
+	#include "xtime_l.h"
+#endif
+
+#ifdef APE_RING_SHARED
+	#include "xil_cache.h"
+#endif
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_RING_SIZE		32		/*!< numero di eventi della coda, potenza di due*/
+#define APE_RING_CACHE_LINE	32		/*!< dimensione della linea di cache L1 del Cortex-A9*/
+
+/**
+  * @brief manutenzione della cache sui dati condivisi tra CPU
+  */
+#ifdef APE_RING_SHARED
+	#define APE_RING_CLEAN(addr,len)		Xil_DCacheFlushRange((INTPTR)(addr),(len))		/*!< scrive in memoria la linea*/
+	#define APE_RING_INVALIDATE(addr,len)	Xil_DCacheInvalidateRange((INTPTR)(addr),(len))	/*!< scarta la copia in cache*/
+#else
+	#define APE_RING_CLEAN(addr,len)		((void)0)
+	#define APE_RING_INVALIDATE(addr,len)	((void)0)
+#endif
+
+/**
+  * @brief barriera di memoria tra la scrittura dei dati e quella dell'indice
+  */
+#if defined(__arm__)
+	#define APE_RING_BARRIER()	__asm__ __volatile__("dmb" ::: "memory")
+#else
+	#define APE_RING_BARRIER()	__sync_synchronize()
+#endif
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief evento registrato dalla IRQ Handler
+  */
+typedef struct {
+	uint32_t pending;	/*!< bit di ISR serviti*/
+	uint32_t data;		/*!< valore del registro dato al momento dell'interrupt*/
+	uint64_t timestamp;	/*!< istante dell'interrupt in cicli del global timer (0 se non disponibile)*/
+} gpio_event_t;
+
+/**
+  * @brief coda circolare di eventi
+  */
+typedef struct {
+	volatile uint32_t head __attribute__((aligned(APE_RING_CACHE_LINE)));	/*!< eventi scritti, modificato solo dal produttore*/
+	volatile uint32_t dropped;												/*!< eventi scartati a coda piena, modificato solo dal produttore*/
+	volatile uint32_t tail __attribute__((aligned(APE_RING_CACHE_LINE)));	/*!< eventi letti, modificato solo dal consumatore*/
+	gpio_event_t buf[APE_RING_SIZE] __attribute__((aligned(APE_RING_CACHE_LINE)));	/*!< buffer degli eventi*/
+} gpio_ring_t;
+
+/* Funzioni inline -----------------------------------------------------------*/
+
+/**
+  * @brief  restituisce l'istante corrente in cicli del global timer
+  * @retval l'istante corrente, 0 se il timer non e' disponibile
+  */
+static inline uint64_t APE_RING_timestamp(void){
+#ifdef DRIVER_BARE
+	XTime now;
+	XTime_GetTime(&now);
+	return (uint64_t)now;
+#else
+	return 0;
+#endif
+}
+
+/**
+  * @brief  inizializza una coda vuota
+  * @param 	self: puntatore alla coda
+  * @retval None
+  */
+static inline void APE_RING_Init(gpio_ring_t* self){
+	self->head = 0;
+	self->tail = 0;
+	self->dropped = 0;
+	APE_RING_CLEAN(self,sizeof(gpio_ring_t));
+}
+
+/**
+  * @brief  inserisce un evento, da chiamare solo dal produttore
+  * @param 	self: puntatore alla coda
+  * @param 	event: evento da inserire
+  * @retval true se l'evento e' stato inserito, false se la coda e' piena
+  */
+static inline bool APE_RING_push(gpio_ring_t* self,const gpio_event_t* event){
+	uint32_t head = self->head;
+	gpio_event_t* slot = &self->buf[head & (APE_RING_SIZE - 1)];
+
+	APE_RING_INVALIDATE(&self->tail,sizeof(self->tail));
+	if(head - self->tail >= APE_RING_SIZE){
+		self->dropped++;
+		APE_RING_CLEAN(&self->head,APE_RING_CACHE_LINE);
+		return false;
+	}
+	*slot = *event;
+	APE_RING_CLEAN(slot,sizeof(gpio_event_t));
+	APE_RING_BARRIER();
+	self->head = head + 1;
+	APE_RING_CLEAN(&self->head,APE_RING_CACHE_LINE);
+	return true;
+}
+
+/**
+  * @brief  estrae un evento, da chiamare solo dal consumatore
+  * @param 	self: puntatore alla coda
+  * @param 	event: destinazione dell'evento estratto
+  * @retval true se e' stato estratto un evento, false se la coda e' vuota
+  */
+static inline bool APE_RING_pop(gpio_ring_t* self,gpio_event_t* event){
+	uint32_t tail = self->tail;
+	gpio_event_t* slot = &self->buf[tail & (APE_RING_SIZE - 1)];
+
+	APE_RING_INVALIDATE(&self->head,APE_RING_CACHE_LINE);
+	if(tail == self->head){
+		return false;
+	}
+	APE_RING_BARRIER();
+	APE_RING_INVALIDATE(slot,sizeof(gpio_event_t));
+	*event = *slot;
+	APE_RING_BARRIER();
+	self->tail = tail + 1;
+	APE_RING_CLEAN(&self->tail,sizeof(self->tail));
+	return true;
+}
+
+/**
+  * @brief  verifica se la coda contiene eventi, dal lato del consumatore
+  * @param 	self: puntatore alla coda
+  * @retval true se la coda e' vuota
+  */
+static inline bool APE_RING_empty(gpio_ring_t* self){
+	APE_RING_INVALIDATE(&self->head,APE_RING_CACHE_LINE);
+	return (self->head == self->tail) ? true : false;
+}
+
+#endif /* SRC_GPIO_RING_H_ */
+/**@}*/
+/**@}*/
@@ -0,0 +1,131 @@
+/**
+  ******************************************************************************
+  * @file    gpio_rtos.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa l'adattatore FreeRTOS del driver
+  * 		 BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "gpio_rtos.h"
+
+#ifdef APE_FREERTOS
+
+#include "gpio_LL_inline.h"
+
+/**
+  * @brief  task di un banco: attende le maschere inviate dalla IRQ Handler
+  * 		e invoca le callback dei pin pendenti
+  * @param  context: puntatore all'adattatore
+  * @retval None
+  */
+static void APE_RTOS_bankTask(void* context){
+	gpio_rtos_t* self = context;
+	uint32_t pending;
+
+	for(;;){
+		if(pdTRUE == xTaskNotifyWait(0,0xFFFFFFFF,&pending,portMAX_DELAY)){
+			APE_IT_dispatch(self->table,pending);
+		}
+	}
+}
+
+/**
+  * @brief  crea un task per ogni banco
+  * @param  self: puntatore all'adattatore
+  * @param  table: tabella con le callback dei pin
+  * @param  banks: vettore dei banchi, deve restare valido
+  * @param  count: numero di banchi
+  * @retval XST_SUCCESS oppure XST_FAILURE se la creazione di un task fallisce:
+  * 		in tal caso i task gia' creati sono eliminati, i loro handle
+  * 		azzerati e l'adattatore resta senza banchi
+  */
+int APE_RTOS_Init(gpio_rtos_t* self,gpio_it_t* table,gpio_rtos_bank_t* banks,int count){
+	int i;
+
+	self->table = table;
+	self->banks = banks;
+	self->count = 0;
+	self->unrouted = 0;
+
+	for(i = 0; i < count; i++){
+		if(pdPASS != xTaskCreate(&APE_RTOS_bankTask,banks[i].name,APE_RTOS_STACK_SIZE,self,banks[i].priority,&banks[i].task)){
+			banks[i].task = NULL;
+			while(i-- > 0){
+				vTaskDelete(banks[i].task);
+				banks[i].task = NULL;
+			}
+			return XST_FAILURE;
+		}
+	}
+	self->count = count;
+	return XST_SUCCESS;
+}
+
+/**
+  * @brief  collega la IRQ Handler dell'adattatore alla linea di una periferica
+  * @param  intc: GIC gia' inizializzato
+  * @param  instance: periferica da collegare (il campo table e' ignorato)
+  * @param  self: puntatore all'adattatore
+  * @retval XST_SUCCESS, oppure XST_FAILURE se la priorita' nel GIC non
+  * 		consente le chiamate FromISR o il collegamento fallisce
+  */
+int APE_RTOS_connect(XScuGic* intc,const APE_IT_instance_t* instance,gpio_rtos_t* self){
+	if(instance->priority < (configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT)){
+		return XST_FAILURE;
+	}
+	if(instance->base_addr != NULL){
+		self->table->base_addr = instance->base_addr;
+	}
+
+	XScuGic_SetPriorityTriggerType(intc,instance->irq_id,instance->priority,instance->trigger);
+	if(XST_SUCCESS != XScuGic_Connect(intc,instance->irq_id,(Xil_InterruptHandler)APE_RTOS_IRQHandler,self)){
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(intc,instance->irq_id);
+	return XST_SUCCESS;
+}
+
+/**
+  * @brief  IRQ Handler dell'adattatore: legge e azzera ISR e notifica i task
+  * 		dei banchi con pin pendenti
+  * @param  context: puntatore all'adattatore
+  * @retval None
+  */
+void APE_RTOS_IRQHandler(void* context){
+	gpio_rtos_t* self = context;
+	BaseType_t woken = pdFALSE;
+	uint32_t pending;
+	uint32_t routed = 0;
+	int i;
+
+	/* Legge il registro ISR e azzera i bit letti */
+	pending = APE_READ32(self->table->base_addr,APE_ICRISR_REG);
+	APE_WRITE32(self->table->base_addr,APE_ICRISR_REG,pending);
+
+	/* Inoltra a ciascun banco i propri pin */
+	for(i = 0; i < self->count; i++){
+		uint32_t bits = pending & self->banks[i].mask;
+
+		if(bits != 0){
+			xTaskNotifyFromISR(self->banks[i].task,bits,eSetBits,&woken);
+			routed |= bits;
+		}
+	}
+	self->unrouted |= pending & ~routed;
+
+	portYIELD_FROM_ISR(woken);
+}
+
+#endif /* APE_FREERTOS */
+/**@}*/
+/**@}*/
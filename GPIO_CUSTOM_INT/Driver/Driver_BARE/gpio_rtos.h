@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file    gpio_rtos.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce l'adattatore FreeRTOS del driver
+  * 		 BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  * @brief   Adattatore FreeRTOS, compilato solo se e' definita APE_FREERTOS.
+  * @details La IRQ Handler dell'adattatore legge e azzera ISR e, per ogni
+  * 		 banco che ha pin pendenti, invia la maschera al task del banco con
+  * 		 xTaskNotifyFromISR (i bit si accumulano se il task e' occupato). Il
+  * 		 task del banco invoca le callback della tabella gpio_it_t con
+  * 		 APE_IT_dispatch alla priorita' FreeRTOS scelta per il banco, quindi
+  * 		 una callback lunga non allunga la latenza delle interrupt.
+  * 		 La priorita' della linea nel GIC deve permettere le chiamate FromISR,
+  * 		 cioe' essere numericamente non inferiore a
+  * 		 configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT; nel port
+  * 		 Zynq il GIC gia' inizializzato e' xInterruptController.
+  * 		 @code
+  * 		 static gpio_rtos_bank_t banks[] = {
+  * 		 	{ "btn", BTN_ALL_MASK, tskIDLE_PRIORITY + 3, NULL },
+  * 		 	{ "sw",  SW_ALL_MASK,  tskIDLE_PRIORITY + 1, NULL },
+  * 		 };
+  * 		 static gpio_rtos_t rtos;
+  * 		 APE_RTOS_Init(&rtos,&APE_IT_gpio0,banks,2);
+  * 		 APE_RTOS_connect(&xInterruptController,&gpio_instances[0],&rtos);
+  * 		 @endcode
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_RTOS_H_
+#define SRC_GPIO_RTOS_H_
+
+#ifdef APE_FREERTOS
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "gpio_it.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_RTOS_STACK_SIZE		(configMINIMAL_STACK_SIZE * 2)	/*!< stack dei task dei banchi, in word*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief banco servito da un task
+  */
+typedef struct {
+	const char* name;		/*!< nome del task*/
+	uint32_t mask;			/*!< pin del banco, nelle posizioni del registro*/
+	UBaseType_t priority;	/*!< priorita' FreeRTOS del task*/
+	TaskHandle_t task;		/*!< task creato da APE_RTOS_Init*/
+} gpio_rtos_bank_t;
+
+/**
+  * @brief adattatore di una periferica APE_GPIO
+  */
+typedef struct {
+	gpio_it_t* table;			/*!< tabella delle callback*/
+	gpio_rtos_bank_t* banks;	/*!< banchi della periferica*/
+	int count;					/*!< numero di banchi*/
+	uint32_t unrouted;			/*!< pin pendenti non appartenenti ad alcun banco*/
+} gpio_rtos_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+int APE_RTOS_Init(gpio_rtos_t*,gpio_it_t*,gpio_rtos_bank_t*,int);
+int APE_RTOS_connect(XScuGic*,const APE_IT_instance_t*,gpio_rtos_t*);
+void APE_RTOS_IRQHandler(void*);
+
+#endif /* APE_FREERTOS */
+
+#endif /* SRC_GPIO_RTOS_H_ */
+/**@}*/
+/**@}*/
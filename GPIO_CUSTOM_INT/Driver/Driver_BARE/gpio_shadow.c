@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    gpio_shadow.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa la copia software dei registri di
+  * 		 configurazione della periferica APE_GPIO.
+  *
+  *	@addtogroup LIB_OBJECTS
+  * @{
+  * @addtogroup GPIO_SHADOW
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes -------------------------------------------------------------------*/
+#include <stddef.h>
+#include "gpio_shadow.h"
+
+/* Private variables ---------------------------------------------------------*/
+static gpio_shadow_t APE_SHADOW_pool[APE_SHADOW_MAX];	/*!< copie delle periferiche*/
+static gpio_shadow_t* APE_SHADOW_last = NULL;			/*!< ultima copia utilizzata*/
+
+/**
+  * @brief  legge dalla periferica i registri di configurazione
+  * @param 	shadow: puntatore alla copia
+  * @retval	None
+  */
+static void APE_SHADOW_load(gpio_shadow_t* shadow){
+	shadow->dir = APE_READ32(shadow->base_addr,APE_DIR_REG);
+	shadow->ierr = APE_READ32(shadow->base_addr,APE_IERR_REG);
+	shadow->ierf = APE_READ32(shadow->base_addr,APE_IERF_REG);
+}
+
+/**
+  * @brief  restituisce la copia associata ad un indirizzo base, allocandola
+  * 		e leggendola dalla periferica al primo utilizzo
+  * @param 	base_addr: indirizzo base della periferica
+  * @retval	puntatore alla copia, NULL se non ci sono copie libere
+  */
+gpio_shadow_t* APE_SHADOW_get(uint32_t* base_addr){
+	gpio_shadow_t* free_slot = NULL;
+	int i;
+
+	if(APE_SHADOW_last != NULL && APE_SHADOW_last->base_addr == base_addr){
+		return APE_SHADOW_last;
+	}
+
+	for(i = 0; i < APE_SHADOW_MAX; i++){
+		if(!APE_SHADOW_pool[i].used){
+			if(free_slot == NULL){
+				free_slot = &APE_SHADOW_pool[i];
+			}
+		}else if(APE_SHADOW_pool[i].base_addr == base_addr){
+			APE_SHADOW_last = &APE_SHADOW_pool[i];
+			return APE_SHADOW_last;
+		}
+	}
+
+	if(free_slot != NULL){
+		free_slot->used = true;
+		free_slot->base_addr = base_addr;
+		APE_SHADOW_load(free_slot);
+		APE_SHADOW_last = free_slot;
+	}
+	return free_slot;
+}
+
+/**
+  * @brief  rilegge dalla periferica la copia dei registri di configurazione
+  * @param 	base_addr: indirizzo base della periferica
+  * @retval	None
+  */
+void APE_SHADOW_resync(uint32_t* base_addr){
+	gpio_shadow_t* shadow = APE_SHADOW_get(base_addr);
+
+	if(shadow != NULL){
+		APE_SHADOW_load(shadow);
+	}
+}
+
+/**
+  * @brief  libera la copia associata ad un indirizzo base, ad esempio prima
+  * 		della munmap: il successivo utilizzo dell'indirizzo rilegge i
+  * 		registri dalla periferica
+  * @param 	base_addr: indirizzo base della periferica
+  * @retval	None
+  */
+void APE_SHADOW_invalidate(uint32_t* base_addr){
+	int i;
+
+	for(i = 0; i < APE_SHADOW_MAX; i++){
+		if(APE_SHADOW_pool[i].used && APE_SHADOW_pool[i].base_addr == base_addr){
+			APE_SHADOW_pool[i].used = false;
+			if(APE_SHADOW_last == &APE_SHADOW_pool[i]){
+				APE_SHADOW_last = NULL;
+			}
+		}
+	}
+}
+
+/**
+  * @brief  imposta a '1' i bit di set e a '0' quelli di clear di un
+  * 		registro di configurazione con una sola scrittura.
+  * @note	se non ci sono copie libere il registro e' aggiornato con una
+  * 		lettura e una scrittura, come in assenza del modulo
+  * @param 	base_addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * 	Questo parametro può assumere i seguenti valori:
+  *     	@arg APE_DIR_REG
+  *     	@arg APE_IERR_REG
+  *     	@arg APE_IERF_REG
+  * @param 	set: maschera dei bit da impostare a '1'
+  * @param 	clear: maschera dei bit da impostare a '0'
+  * @retval	None
+  */
+void APE_SHADOW_update(uint32_t* base_addr,int offset,uint32_t set,uint32_t clear){
+	gpio_shadow_t* shadow = APE_SHADOW_get(base_addr);
+	uint32_t* reg;
+
+	if(shadow == NULL){
+		APE_write32(base_addr,offset,(APE_read32(base_addr,offset) & ~clear) | set);
+		return;
+	}
+
+	switch(offset){
+	case APE_DIR_REG:
+		reg = &shadow->dir;
+		break;
+	case APE_IERR_REG:
+		reg = &shadow->ierr;
+		break;
+	case APE_IERF_REG:
+		reg = &shadow->ierf;
+		break;
+	default:
+		return;
+	}
+
+	*reg = (*reg & ~clear) | set;
+	APE_write32(base_addr,offset,*reg);
+}
+/**@}*/
+/**@}*/
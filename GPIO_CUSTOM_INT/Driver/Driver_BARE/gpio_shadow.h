@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    gpio_shadow.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce la copia software dei registri di
+  * 		 configurazione della periferica APE_GPIO.
+  *
+  *	@addtogroup LIB_OBJECTS
+  * @{
+  * @addtogroup GPIO_SHADOW
+  * @{
+  * @brief Questo modulo mantiene una copia (shadow) dei registri DIR, IERR e
+  * 	   IERF per ogni indirizzo base.
+  * @details I registri di configurazione cambiano solo per scrittura software,
+  * 		 pertanto btn_t, led_t e switch_t li aggiornano sulla copia e
+  * 		 scrivono il risultato senza rileggere la periferica: ogni modifica
+  * 		 costa una sola scrittura invece di una lettura e una scrittura.
+  * 		 La copia e' condivisa da tutti i banchi mappati sullo stesso indirizzo
+  * 		 base, quindi e' ricercata per indirizzo ad ogni accesso: nel driver UIO
+  * 		 il base address puo' essere ridefinito dopo la mmap senza altri passi.
+  * 		 Al primo utilizzo di un indirizzo la copia e' letta dalla periferica.
+  * 		 Se i registri vengono scritti senza passare da questo modulo (ad
+  * 		 esempio con APE_writeValue32) e' necessario chiamare APE_SHADOW_resync.
+  * 		 Quando la mappatura di una periferica viene rimossa (munmap nel
+  * 		 driver UIO) la copia va liberata con APE_SHADOW_invalidate: lo
+  * 		 stesso indirizzo puo' essere riassegnato ad un'altra periferica.
+  * 		 L'indirizzo NULL e' valido (GPIO_0_BASE_ADDRESS nei driver SIM e UIO).
+  * @note	 Il modulo non e' rientrante: la configurazione non va modificata
+  * 		 contemporaneamente dal programma principale e da una IRQ Handler.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_SHADOW_H_
+#define SRC_GPIO_SHADOW_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_LL_inline.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_SHADOW_MAX		4	/*!< numero massimo di periferiche con copia dei registri*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief copia dei registri di configurazione di una periferica
+  */
+typedef struct {
+	bool used;				/*!< copia assegnata ad una periferica*/
+	uint32_t* base_addr;	/*!< indirizzo base della periferica*/
+	uint32_t dir;			/*!< copia del registro DIR*/
+	uint32_t ierr;			/*!< copia del registro IERR*/
+	uint32_t ierf;			/*!< copia del registro IERF*/
+} gpio_shadow_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+gpio_shadow_t* APE_SHADOW_get(uint32_t*);
+void APE_SHADOW_resync(uint32_t*);
+void APE_SHADOW_invalidate(uint32_t*);
+void APE_SHADOW_update(uint32_t*,int,uint32_t,uint32_t);
+
+#endif /* SRC_GPIO_SHADOW_H_ */
+/**@}*/
+/**@}*/
@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    gpio_snapshot.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce la fotografia dello stato di una
+  * 		 periferica APE_GPIO.
+  *
+  *	@addtogroup LIB_OBJECTS
+  * @{
+  * @addtogroup GPIO_SNAPSHOT
+  * @{
+  * @brief Questo modulo legge una sola volta i registri DATA ed eventualmente
+  * 	   ICRISR di una periferica.
+  * @details Le funzioni decode di btn_t, led_t e switch_t estraggono i propri
+  * 		 pin dalla fotografia invece di leggere la periferica: un ciclo di
+  * 		 polling costa un solo accesso per periferica e tutti i banchi
+  * 		 vedono lo stato dello stesso istante.
+  * 		 @code
+  * 		 gpio_snapshot_t snap;
+  * 		 APE_SNAP_Init(&snap,(uint32_t*)GPIO_0_BASE_ADDRESS);
+  * 		 APE_SNAP_capture(&snap);
+  * 		 sw = s.decodeStatus(&s,&snap);
+  * 		 btn = b.decodeStatus(&b,&snap);
+  * 		 @endcode
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_SNAPSHOT_H_
+#define SRC_GPIO_SNAPSHOT_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_LL_inline.h"
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief fotografia dei registri di una periferica
+  */
+typedef struct {
+	uint32_t* base_addr;	/*!< indirizzo base della periferica*/
+	uint32_t data;			/*!< valore del registro DATA all'ultima lettura*/
+	uint32_t isr;			/*!< valore del registro ISR all'ultima lettura*/
+} gpio_snapshot_t;
+
+/* Funzioni inline -----------------------------------------------------------*/
+
+/**
+  * @brief  inizializza la fotografia di una periferica
+  * @param 	self: puntatore alla fotografia
+  * @param 	base_addr: indirizzo base della periferica
+  * @retval	None
+  */
+static inline void APE_SNAP_Init(gpio_snapshot_t* self,uint32_t* base_addr){
+	self->base_addr = base_addr;
+	self->data = 0;
+	self->isr = 0;
+}
+
+/**
+  * @brief  legge il registro DATA
+  * @param 	self: puntatore alla fotografia
+  * @retval	il valore letto
+  */
+static inline uint32_t APE_SNAP_capture(gpio_snapshot_t* self){
+	self->data = APE_READ32(self->base_addr,APE_DATA_REG);
+	return self->data;
+}
+
+/**
+  * @brief  legge i registri DATA e ISR
+  * @param 	self: puntatore alla fotografia
+  * @retval	il valore del registro DATA
+  */
+static inline uint32_t APE_SNAP_captureAll(gpio_snapshot_t* self){
+	self->isr = APE_READ32(self->base_addr,APE_ICRISR_REG);
+	self->data = APE_READ32(self->base_addr,APE_DATA_REG);
+	return self->data;
+}
+
+#endif /* SRC_GPIO_SNAPSHOT_H_ */
+/**@}*/
+/**@}*/
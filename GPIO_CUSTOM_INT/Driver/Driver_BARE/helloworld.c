@@ -13,10 +13,19 @@
   *	@details Il programma testa le interrupt lanciate dai bottoni e dagli
   *          switch. Ad ogni bottone e ad ogni switch corrisponde una callback,
   *          che effettua il toggle del led alla medesima posizione.
+  *			 Nelle callback i led sono acceduti mediante i banchi a dispatch
+  *			 statico di gpio_pins.h, senza chiamate indirette; il loop legge gli
+  *			 switch da una fotografia della periferica (gpio_snapshot.h).
   *			 Le funzioni di callback sono dichiarate __weak, pertanto l'utente 
   *			 puo' ridefinirle qualora abbia attivato le interrupt per una specifica linea.
-  *			 Le callback vengono poi invocate dalla IRQ_Handler che invece definita
-  *			 nel file gpio_it.h.
+  *			 Le callback vengono poi invocate dallo scheduler (scheduler.h), a
+  *			 partire dagli eventi che la IRQ_Handler definita nel file gpio_it.h
+  *			 registra nella coda; tra un evento e l'altro la CPU resta in WFI e
+  *			 il loop e' un timer software eseguito ogni LOOP_PERIOD_TICKS tick.
+  *			 Le interrupt di bottoni e switch non invocano direttamente le
+  *			 callback: avviano il timer di debounce, che campiona il registro
+  *			 dato ogni DEB_PERIOD_TICKS tick finche' il filtro (debounce.h) ha
+  *			 pin in transizione e invoca le callback solo per i fronti filtrati.
   ******************************************************************************
   */
 
@@ -25,27 +34,64 @@
 #include "platform.h"
 #include "xil_printf.h"
 #include "gpio_it.h"
+#include "scheduler.h"
 #include "xscugic.h"
+#include "xscutimer.h"
 #include "xil_exception.h"
 #include "button.h"
 #include "led.h"
 #include "switch.h"
+#include "gpio_pins.h"
+#include "gpio_profile.h"
+#include "debounce.h"
 
 /* Macro ----------------------------------------------------------------------*/
 #define GPIO_DEVICE_ID 		XPAR_GPIO_CUSTOM_IPCORE_0_DEVICE_ID /*!< ID della periferica*/
 #define INTC_DEVICE_ID 		XPAR_SCUGIC_SINGLE_DEVICE_ID 		/*!< ID del GIC*/
 #define GPIO_INTERRUPT_ID 	XPS_FPGA0_INT_ID /*!< ID della linea di interrupt*/
+#define TIMER_DEVICE_ID		XPAR_XSCUTIMER_0_DEVICE_ID	/*!< ID del timer privato*/
+#define TIMER_INTERRUPT_ID	XPAR_SCUTIMER_INTR			/*!< ID della linea di interrupt del timer*/
+#define TICK_HZ				1000						/*!< frequenza del tick dello scheduler*/
+#define LOOP_PERIOD_TICKS	10							/*!< periodo di lettura degli switch in tick*/
+#define DEB_PERIOD_TICKS	5							/*!< periodo di campionamento del debounce in tick*/
+#define DEB_PINS			(BTN_ALL_MASK | SW_ALL_MASK)	/*!< pin filtrati dal debounce*/
+#define PROFILE_PERIOD_TICKS	5000					/*!< periodo di stampa dei profili in tick (con APE_PROFILE)*/
 
 /* Private variables ---------------------------------------------------------*/
 static XScuGic Intc; /*!< Handler del GIC*/
+static XScuTimer Timer; /*!< Handler del timer privato*/
+static sched_timer_t loop_timer; /*!< Timer software della lettura degli switch*/
+static sched_timer_t deb_timer; /*!< Timer software del debounce, attivo solo durante le transizioni*/
+static bool deb_active; /*!< true se deb_timer e' avviato*/
+static debounce_t deb; /*!< Filtro antirimbalzo di bottoni e switch*/
+static gpio_it_t debounced; /*!< Callback invocate sui fronti filtrati*/
+#ifdef APE_PROFILE
+static sched_timer_t profile_timer; /*!< Timer software della stampa dei profili*/
+#endif
 btn_t b;	/*!< Handler dei bottoni*/
 led_t l;	/*!< Handler dei led*/
 switch_t s;	/*!< Handler degli switch*/
 switch_state state[4]; /*!< Stato degli switch*/
+gpio_snapshot_t snap;	/*!< Fotografia della periferica GPIO_0*/
+static gpio_ring_t ring;	/*!< Coda degli eventi della periferica GPIO_0*/
+
+/**
+  * @brief periferiche APE_GPIO collegate al GIC: per aggiungerne una basta
+  * 		una riga con la sua tabella, la linea di interrupt e la priorita'
+  */
+static const APE_IT_instance_t gpio_instances[] = {
+	{ &APE_IT_gpio0, (uint32_t*)GPIO_0_BASE_ADDRESS, GPIO_INTERRUPT_ID, 0xA0, APE_IT_TRIGGER_RISING },
+};
 
 /* Private function prototypes -----------------------------------------------*/
 void setup(void);
-void loop(void);
+void loop(void* context);
+void tickHandler(void* context);
+void edge(void* context,int pin);
+void debounce(void* context);
+#ifdef APE_PROFILE
+void profileDump(void* context);
+#endif
 
 int main()
 {
@@ -68,17 +114,11 @@ int main()
 		return XST_FAILURE;
 	}
 
-	/* 2: Setta la priorità per la sorgente IRQ*/
-	XScuGic_SetPriorityTriggerType(&Intc,GPIO_INTERRUPT_ID,0xA0,0x3);
-
-	/* 3: gpiohandler è la funzione di gestione delle interrupt */
-	if(XST_SUCCESS != XScuGic_Connect(&Intc,GPIO_INTERRUPT_ID,(Xil_ExceptionHandler)APE_IRQHandler_0,NULL)){
+	/* 2-4: Setta priorità e sensibilità, collega l'handler generico e abilita le interrupt di ogni periferica GPIO*/
+	if(XST_SUCCESS != APE_IT_connect(&Intc,gpio_instances,sizeof(gpio_instances) / sizeof(gpio_instances[0]))){
 		return XST_FAILURE;
 	}
 
-	/* 4: Abilita le interrupt per il device GPIO*/
-	XScuGic_Enable(&Intc, GPIO_INTERRUPT_ID);
-
 	/* 5: Abilita interrupt su entrambi i fronti per bottoni e switch*/
 	b.enableInterrupt(&b,0xF,INT_RIS_FALL);
 	s.enableInterrupt(&s,0xF,INT_RIS_FALL);
@@ -89,12 +129,33 @@ int main()
 	/* 7: registra l'interrupt controller handler con la exception table*/
 	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,(Xil_ExceptionHandler)XScuGic_InterruptHandler,&Intc);
 
-	/* 8: abilita eccezioni */
+	/* 8: Configura il timer privato come tick dello scheduler (il timer conta a meta' della frequenza della CPU)*/
+	XScuTimer_Config *TimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
+	if (NULL == TimerConfig){
+		return XST_FAILURE;
+	}
+
+	if(XST_SUCCESS != XScuTimer_CfgInitialize(&Timer,TimerConfig,TimerConfig->BaseAddr)){
+		return XST_FAILURE;
+	}
+
+	XScuTimer_LoadTimer(&Timer,XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2 / TICK_HZ);
+	XScuTimer_EnableAutoReload(&Timer);
+
+	if(XST_SUCCESS != XScuGic_Connect(&Intc,TIMER_INTERRUPT_ID,(Xil_ExceptionHandler)tickHandler,&Timer)){
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(&Intc,TIMER_INTERRUPT_ID);
+	XScuTimer_EnableInterrupt(&Timer);
+	XScuTimer_Start(&Timer);
+
+	/* 9: abilita eccezioni */
 	Xil_ExceptionEnable();
 
     /*-------------------------------------------------------------------------------------------*/
 
-    for(;;)loop();
+    /* Tra un evento e l'altro la CPU resta in WFI */
+    for(;;)APE_SCHED_run();
 
     cleanup_platform();
     return 0;
@@ -106,6 +167,7 @@ int main()
   * @retval None
   */
 void setup(void){
+	int pin;
 
 	/*Inizializza handler bottoni e setta la direzione*/
 	BTN_Init(&b);
@@ -121,19 +183,111 @@ void setup(void){
 
 	/*Spegni tutti i led*/
 	l.setLeds(&l,0x0);
+
+	/*Inizializza la fotografia della periferica su cui sono mappati gli switch*/
+	APE_SNAP_Init(&snap,(uint32_t*)SW_BASE_ADDRESS);
+
+	/*Sposta le callback dei bottoni e degli switch dietro al debounce: le
+	  interrupt avviano solo il campionamento*/
+	APE_DEB_Init(&deb,DEB_PINS,APE_SNAP_capture(&snap));
+	debounced = APE_IT_gpio0;
+	for(pin = 0; pin < APE_IT_MAX_PINS; pin++){
+		if(DEB_PINS & (1u << pin)){
+			APE_IT_register(&APE_IT_gpio0,pin,&edge,NULL);
+		}
+	}
+
+	/*Differisce le callback allo scheduler: la IRQ Handler registra solo l'evento*/
+	APE_RING_Init(&ring);
+	APE_IT_setRing(&APE_IT_gpio0,&ring);
+
+	/*Serve la coda della periferica e legge periodicamente gli switch*/
+	APE_SCHED_Init();
+	APE_SCHED_addSource(&APE_IT_gpio0);
+	APE_SCHED_startTimer(&loop_timer,&loop,NULL,LOOP_PERIOD_TICKS,LOOP_PERIOD_TICKS);
+#ifdef APE_PROFILE
+	/*Stampa periodicamente i tempi della IRQ Handler e delle callback*/
+	APE_PROF_reset();
+	APE_SCHED_startTimer(&profile_timer,&profileDump,NULL,PROFILE_PERIOD_TICKS,PROFILE_PERIOD_TICKS);
+#endif
+}
+
+/**
+  * @brief  IRQ Handler del timer privato, conta un tick dello scheduler
+  * @param  context: puntatore all'handler del timer
+  * @retval None
+  */
+void tickHandler(void* context){
+	XScuTimer_ClearInterruptStatus((XScuTimer*)context);
+	APE_SCHED_tick();
 }
 
+/**
+  * @brief  Callback dei fronti non filtrati di bottoni e switch: avvia il
+  * 		campionamento del debounce se non e' gia' in corso.
+  * @param  context: non utilizzato
+  * @param  pin: pin che ha generato l'interrupt
+  * @retval None
+  */
+void edge(void* context,int pin){
+	(void)context;
+	(void)pin;
+
+	if(!deb_active){
+		deb_active = true;
+		APE_SCHED_startTimer(&deb_timer,&debounce,NULL,DEB_PERIOD_TICKS,DEB_PERIOD_TICKS);
+	}
+}
+
+/**
+  * @brief  Campiona il registro dato ogni DEB_PERIOD_TICKS tick, invoca le
+  * 		callback dei pin il cui stato filtrato e' cambiato e si ferma
+  * 		quando nessun pin e' in transizione.
+  * @param  context: non utilizzato
+  * @retval None
+  */
+void debounce(void* context){
+	(void)context;
+
+	if(APE_DEB_sample(&deb,APE_SNAP_capture(&snap))){
+		APE_IT_dispatch(&debounced,deb.rising | deb.falling);
+	}
+	if(APE_DEB_busy(&deb) == 0){
+		APE_SCHED_stopTimer(&deb_timer);
+		deb_active = false;
+	}
+}
+
+#ifdef APE_PROFILE
+/**
+  * @brief  Stampa i tempi della IRQ Handler e delle callback, ogni
+  * 		PROFILE_PERIOD_TICKS tick dello scheduler.
+  * @param  context: non utilizzato
+  * @retval None
+  */
+void profileDump(void* context){
+	(void)context;
+	APE_PROF_dump();
+}
+#endif
+
 /**
   * @brief  Legge lo stato di ogni switch e lo salva nella variabile
-  * 		corrispondente
-  * @param  None
+  * 		corrispondente, ogni LOOP_PERIOD_TICKS tick dello scheduler. Il
+  * 		registro dato e' letto una sola volta, quindi gli stati si
+  * 		riferiscono allo stesso istante.
+  * @param  context: non utilizzato
   * @retval None
   */
-void loop(void){
-	state[0] = s.readSwitch(&s,SW0);
-	state[1] = s.readSwitch(&s,SW1);
-	state[2] = s.readSwitch(&s,SW2);
-	state[3] = s.readSwitch(&s,SW3);
+void loop(void* context){
+	(void)context;
+
+	APE_SNAP_capture(&snap);
+
+	state[0] = s.decodeSwitch(&s,&snap,SW0);
+	state[1] = s.decodeSwitch(&s,&snap,SW1);
+	state[2] = s.decodeSwitch(&s,&snap,SW2);
+	state[3] = s.decodeSwitch(&s,&snap,SW3);
 }
 
 /**
@@ -142,7 +296,7 @@ void loop(void){
   * @retval None
   */
 void APE_BTN0_Callback(void){
-	l.toggle(&l,LED0);
+	LED_BANK_toggle(LED0);
 }
 
 /**
@@ -151,7 +305,7 @@ void APE_BTN0_Callback(void){
   * @retval None
   */
 void APE_BTN1_Callback(void){
-	l.toggle(&l,LED1);
+	LED_BANK_toggle(LED1);
 }
 
 /**
@@ -160,7 +314,7 @@ void APE_BTN1_Callback(void){
   * @retval None
   */
 void APE_BTN2_Callback(void){
-	l.toggle(&l,LED2);
+	LED_BANK_toggle(LED2);
 }
 
 /**
@@ -169,7 +323,7 @@ void APE_BTN2_Callback(void){
   * @retval None
   */
 void APE_BTN3_Callback(void){
-	l.toggle(&l,LED3);
+	LED_BANK_toggle(LED3);
 }
 
 /**
@@ -178,7 +332,7 @@ void APE_BTN3_Callback(void){
   * @retval None
   */
 void APE_SW0_Callback(void){
-	l.toggle(&l,LED0);
+	LED_BANK_toggle(LED0);
 }
 
 /**
@@ -187,7 +341,7 @@ void APE_SW0_Callback(void){
   * @retval None
   */
 void APE_SW1_Callback(void){
-	l.toggle(&l,LED1);
+	LED_BANK_toggle(LED1);
 }
 
 /**
@@ -196,7 +350,7 @@ void APE_SW1_Callback(void){
   * @retval None
   */
 void APE_SW2_Callback(void){
-	l.toggle(&l,LED2);
+	LED_BANK_toggle(LED2);
 }
 
 /**
@@ -205,7 +359,7 @@ void APE_SW2_Callback(void){
   * @retval None
   */
 void APE_SW3_Callback(void){
-	l.toggle(&l,LED3);
+	LED_BANK_toggle(LED3);
 }
 /**@}*/
 /**@}*/
\ No newline at end of file
@@ -16,18 +16,43 @@
 /* Includes -------------------------------------------------------------------*/
 #include "led.h"
 
+/* Macro ---------------------------------------------------------------------*/
+
+/**
+  * @brief pin del byte del registro dato che contiene i led, esclusi i led:
+  * 		le store a 8 bit di LED_setLeds e LED_commit li riscrivono
+  */
+#define LED_BYTE_OTHERS		((0xFFu << (LED_NIBBLE_OFFSET / 8 * 8)) & ~LED_ALL_MASK)
+
+/**
+  * @brief pin in ingresso della periferica dei led: il loro latch di scrittura
+  * 		non raggiunge il pad, quindi riscriverlo non ha effetto
+  */
+#if defined(APE_BTN_MOD_ENABLED) && (BTN_BASE_ADDRESS == LED_BASE_ADDRESS)
+	#define LED_INPUTS_BTN	(0xFu << BTN_NIBBLE_OFFSET)
+#else
+	#define LED_INPUTS_BTN	0x0
+#endif
+#if defined(APE_SW_MOD_ENABLED) && (SW_BASE_ADDRESS == LED_BASE_ADDRESS)
+	#define LED_INPUTS_SW	(0xFu << SW_NIBBLE_OFFSET)
+#else
+	#define LED_INPUTS_SW	0x0
+#endif
+
+/**
+  * @brief verifica a tempo di compilazione che il byte dei led non contenga
+  * 		pin in uscita di altri banchi, che le store a 8 bit riporterebbero
+  * 		indietro
+  */
+#define LED_BYTE_CHECK()	APE_STATIC_CHECK((LED_BYTE_OTHERS & ~(LED_INPUTS_BTN | LED_INPUTS_SW)) == 0)
+
 /**
   * @brief  abilita tutti i led
   * @param 	self: puntatore alla struttura
   * @retval	None
   */
 void LED_enable(led_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DIR_REG);
-	uint32_t mask = ~LED_ALL_MASK;
-
-	mask = mask & status;
-
-	APE_writeValue32(self->base_addr,APE_DIR_REG,mask);
+	APE_SHADOW_update(self->base_addr,APE_DIR_REG,0,LED_ALL_MASK);
 }
 
 /**
@@ -36,12 +61,7 @@ void LED_enable(led_t* self){
   * @retval	None
   */
 void LED_disable(led_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DIR_REG);
-	uint32_t mask = LED_ALL_MASK;
-
-	mask = mask | status;
-
-	APE_writeValue32(self->base_addr,APE_DIR_REG,mask);
+	APE_SHADOW_update(self->base_addr,APE_DIR_REG,LED_ALL_MASK,0);
 }
 
 /**
@@ -50,7 +70,7 @@ void LED_disable(led_t* self){
   * @retval	il valore del nibble del registro dato su cui sono mappati i led
   */
 uint32_t LED_readStatus(led_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DATA_REG);
+	uint32_t status = APE_READ32(self->base_addr,APE_DATA_REG);
 	status = (status & LED_ALL_MASK);
 	return (status >> LED_NIBBLE_OFFSET);
 }
@@ -67,7 +87,7 @@ uint32_t LED_readStatus(led_t* self){
   *	@retval	None
   */
 void LED_setOn(led_t* self,led_n led){
-	APE_setBit(self->base_addr,APE_DATA_REG,1,led);
+	APE_SET32(self->base_addr,APE_DATA_REG,0x1u << led);
 }
 
 /**
@@ -82,7 +102,7 @@ void LED_setOn(led_t* self,led_n led){
   * @retval	None
   */
 void LED_setOff(led_t* self,led_n led){
-	APE_setBit(self->base_addr,APE_DATA_REG,0,led);
+	APE_CLEAR32(self->base_addr,APE_DATA_REG,0x1u << led);
 }
 
 /**
@@ -97,17 +117,93 @@ void LED_setOff(led_t* self,led_n led){
   *	@retval	None
   */
 void LED_toggle(led_t* self,led_n led){
-	APE_toggleBit(self->base_addr,APE_DATA_REG,led);
+	APE_TOGGLE32(self->base_addr,APE_DATA_REG,0x1u << led);
 }
 
 /**
   * @brief  accende i led in base ad una maschera
+  * @note	la scrittura e' una store a 8 bit sul solo byte del registro
+  * 		dato che contiene il nibble dei led: gli altri byte non vengono
+  * 		alterati e non serve rileggere il registro.
   * @param 	self: puntatore alla struttura
   * @param 	mask: maschera dei led da accendere
   * @retval	None
   */
 void LED_setLeds(led_t* self,uint32_t mask){
-	APE_writeValue32(self->base_addr,APE_DATA_REG,(mask << LED_NIBBLE_OFFSET));
+	LED_BYTE_CHECK();
+	APE_WRITE8(self->base_addr,APE_DATA_REG,(uint8_t)((mask & 0xF) << (LED_NIBBLE_OFFSET % 8)),LED_NIBBLE_OFFSET / 8);
+}
+
+/**
+  * @brief  estrae il valore dei led da una fotografia della periferica
+  * @param 	self: puntatore alla struttura
+  * @param 	snap: fotografia acquisita con APE_SNAP_capture
+  * @retval	il valore del nibble del registro dato su cui sono mappati dei led
+  */
+uint32_t LED_decodeStatus(led_t* self,const gpio_snapshot_t* snap){
+	(void)self;
+	return (snap->data & LED_ALL_MASK) >> LED_NIBBLE_OFFSET;
+}
+
+/**
+  * @brief  inizia una transazione leggendo una sola volta il registro dato
+  * @param 	self: puntatore alla struttura
+  * @retval	None
+  */
+void LED_begin(led_t* self){
+	self->tx_start = APE_READ32(self->base_addr,APE_DATA_REG);
+	self->tx_data = self->tx_start;
+}
+
+/**
+  * @brief  accende nella transazione i led indicati da una maschera
+  * @param 	self: puntatore alla struttura
+  * @param 	mask: maschera dei led da accendere
+  * @retval	None
+  */
+void LED_set(led_t* self,uint32_t mask){
+	self->tx_data |= (mask & 0xF) << LED_NIBBLE_OFFSET;
+}
+
+/**
+  * @brief  spegne nella transazione i led indicati da una maschera
+  * @param 	self: puntatore alla struttura
+  * @param 	mask: maschera dei led da spegnere
+  * @retval	None
+  */
+void LED_clear(led_t* self,uint32_t mask){
+	self->tx_data &= ~((mask & 0xF) << LED_NIBBLE_OFFSET);
+}
+
+/**
+  * @brief  effettua nella transazione il toggle dei led indicati da una maschera
+  * @param 	self: puntatore alla struttura
+  * @param 	mask: maschera dei led
+  * @retval	None
+  */
+void LED_flip(led_t* self,uint32_t mask){
+	self->tx_data ^= (mask & 0xF) << LED_NIBBLE_OFFSET;
+}
+
+/**
+  * @brief  conclude la transazione scrivendo il solo byte del registro dato
+  * 		che contiene il nibble dei led
+  * @note	se nessun led e' cambiato rispetto a begin la scrittura non avviene
+  * @note	l'altro nibble del byte e' riscritto con il valore letto da begin:
+  * 		una sua modifica tra begin e commit andrebbe persa. Per questo il
+  * 		byte puo' essere condiviso solo con pin in ingresso (bottoni o
+  * 		switch della stessa periferica), il cui latch non raggiunge il pad;
+  * 		la mappatura di defines.h e' verificata a tempo di compilazione.
+  * @param 	self: puntatore alla struttura
+  * @retval	None
+  */
+void LED_commit(led_t* self){
+	LED_BYTE_CHECK();
+	if(((self->tx_data ^ self->tx_start) & LED_ALL_MASK) == 0){
+		return;
+	}
+	APE_WRITE8(self->base_addr,APE_DATA_REG,(uint8_t)(self->tx_data >> (LED_NIBBLE_OFFSET / 8 * 8)),LED_NIBBLE_OFFSET / 8);
+	self->tx_start = self->tx_data;
 }
 
 /**
@@ -120,10 +216,18 @@ void LED_Init(led_t* self){
 	self->enable = &LED_enable;
 	self->disable = &LED_disable;
 	self->readStatus = &LED_readStatus;
+	self->decodeStatus = &LED_decodeStatus;
 	self->setOn = &LED_setOn;
 	self->setOff = &LED_setOff;
 	self->toggle = &LED_toggle;
 	self->setLeds = &LED_setLeds;
+	self->begin = &LED_begin;
+	self->set = &LED_set;
+	self->clear = &LED_clear;
+	self->flip = &LED_flip;
+	self->commit = &LED_commit;
+	self->tx_data = 0;
+	self->tx_start = 0;
 }
 /**@}*/
 /**@}*/
\ No newline at end of file
@@ -12,13 +12,26 @@
   * @{
   * @brief Questo modulo fornisce un'interfaccia di alto livello per
   * 	   utilizzare i led.
+  * @details Per aggiornare piu' led insieme e' disponibile una transazione:
+  * 		 begin legge il registro dato una volta, set, clear e flip modificano
+  * 		 la copia locale e commit la scrive con un'unica store, solo se il
+  * 		 valore e' cambiato. I led cambiano quindi tutti nello stesso istante,
+  * 		 senza stati intermedi visibili.
+  * 		 @code
+  * 		 l.begin(&l);
+  * 		 l.set(&l,0x5);
+  * 		 l.flip(&l,0x8);
+  * 		 l.commit(&l);
+  * 		 @endcode
   ******************************************************************************
   */
 #ifndef SRC_LED_H_
 #define SRC_LED_H_
 
 /* Includes ------------------------------------------------------------------*/
-#include "gpio_LL.h"
+#include "gpio_LL_inline.h"
+#include "gpio_shadow.h"
+#include "gpio_snapshot.h"
 #include "defines.h"
 
 /* Macro ---------------------------------------------------------------------*/
@@ -57,11 +70,19 @@ struct led_t{
 	void (*enable)(led_t* self);
 	void (*disable)(led_t* self);
 	uint32_t (*readStatus)(led_t* self);
+	uint32_t (*decodeStatus)(led_t* self,const gpio_snapshot_t* snap);
 	void (*setOn)(led_t* self,led_n pos);
 	void (*setOff)(led_t* self,led_n pos);
 	void (*toggle)(led_t* self,led_n pos);
 	void (*setLeds)(led_t* self,uint32_t led_mask);
+	void (*begin)(led_t* self);
+	void (*set)(led_t* self,uint32_t led_mask);
+	void (*clear)(led_t* self,uint32_t led_mask);
+	void (*flip)(led_t* self,uint32_t led_mask);
+	void (*commit)(led_t* self);
     uint32_t* base_addr;
+    uint32_t tx_data;	/*!< valore del registro dato accumulato dalla transazione*/
+    uint32_t tx_start;	/*!< valore del registro dato all'inizio della transazione*/
 };
 
 /**
@@ -0,0 +1,277 @@
+/**
+  ******************************************************************************
+  * @file    scheduler.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa lo scheduler ad eventi del driver
+  * 		 BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "scheduler.h"
+
+/* Macro ---------------------------------------------------------------------*/
+
+/**
+  * @brief mascheramento delle IRQ e attesa di una interrupt
+  */
+#if defined(__arm__)
+	#define APE_SCHED_IRQ_DISABLE()	__asm__ __volatile__("cpsid i" ::: "memory")
+	#define APE_SCHED_IRQ_ENABLE()	__asm__ __volatile__("cpsie i" ::: "memory")
+	#define APE_SCHED_WAIT()		__asm__ __volatile__("dsb\n\twfi" ::: "memory")
+#else
+	#define APE_SCHED_IRQ_DISABLE()	((void)0)
+	#define APE_SCHED_IRQ_ENABLE()	((void)0)
+	#define APE_SCHED_WAIT()		((void)0)
+#endif
+
+/**
+  * @brief stati di un timer fuori dalla wheel (campo slot)
+  */
+#define APE_SCHED_STOPPED	(-1)	/*!< timer fermo*/
+#define APE_SCHED_EXPIRED	(-2)	/*!< timer scaduto, callback non ancora invocata*/
+#define APE_SCHED_RUNNING	(-3)	/*!< callback del timer in esecuzione*/
+
+/* Private variables ---------------------------------------------------------*/
+static sched_timer_t* APE_SCHED_wheel[APE_SCHED_WHEEL_SLOTS];	/*!< liste dei timer per posizione*/
+static sched_timer_t* APE_SCHED_expired;						/*!< timer scaduti nel tick corrente*/
+static uint32_t APE_SCHED_now;									/*!< tick elaborati*/
+static volatile uint32_t APE_SCHED_ticks;						/*!< tick contati, modificato solo da APE_SCHED_tick*/
+static gpio_it_t* APE_SCHED_sources[APE_SCHED_MAX_SOURCES];		/*!< tabelle servite*/
+static int APE_SCHED_numSources;								/*!< numero di tabelle servite*/
+static sched_stats_t APE_SCHED_stats;							/*!< statistiche*/
+
+/**
+  * @brief  inserisce un timer in testa ad una lista
+  * @param 	head: testa della lista
+  * @param 	timer: puntatore al timer
+  * @retval None
+  */
+static void APE_SCHED_link(sched_timer_t** head,sched_timer_t* timer){
+	timer->next = *head;
+	timer->pprev = head;
+	if(*head != NULL){
+		(*head)->pprev = &timer->next;
+	}
+	*head = timer;
+}
+
+/**
+  * @brief  rimuove un timer dalla lista in cui si trova
+  * @param 	timer: puntatore al timer
+  * @retval None
+  */
+static void APE_SCHED_unlink(sched_timer_t* timer){
+	*timer->pprev = timer->next;
+	if(timer->next != NULL){
+		timer->next->pprev = timer->pprev;
+	}
+	timer->next = NULL;
+	timer->pprev = NULL;
+}
+
+/**
+  * @brief  inserisce un timer nella wheel
+  * @param 	timer: puntatore al timer
+  * @param 	delay: tick mancanti alla scadenza, almeno 1
+  * @retval None
+  */
+static void APE_SCHED_insert(sched_timer_t* timer,uint32_t delay){
+	int slot = (APE_SCHED_now + delay) & (APE_SCHED_WHEEL_SLOTS - 1);
+
+	timer->rounds = (delay - 1) / APE_SCHED_WHEEL_SLOTS;
+	timer->slot = slot;
+	APE_SCHED_link(&APE_SCHED_wheel[slot],timer);
+}
+
+/**
+  * @brief  avanza la wheel di un tick e invoca le callback dei timer scaduti
+  * @retval None
+  */
+static void APE_SCHED_advance(void){
+	sched_timer_t* timer;
+	sched_timer_t* next;
+
+	APE_SCHED_now++;
+
+	/* Sposta i timer scaduti nella lista APE_SCHED_expired: le callback
+	   possono fermarli o riavviarli prima che siano serviti */
+	for(timer = APE_SCHED_wheel[APE_SCHED_now & (APE_SCHED_WHEEL_SLOTS - 1)]; timer != NULL; timer = next){
+		next = timer->next;
+		if(timer->rounds > 0){
+			timer->rounds--;
+		}else{
+			APE_SCHED_unlink(timer);
+			timer->slot = APE_SCHED_EXPIRED;
+			APE_SCHED_link(&APE_SCHED_expired,timer);
+		}
+	}
+
+	while(APE_SCHED_expired != NULL){
+		timer = APE_SCHED_expired;
+		APE_SCHED_unlink(timer);
+		timer->slot = APE_SCHED_RUNNING;
+		timer->callback(timer->context);
+
+		/* Non fermato ne' riavviato dalla callback */
+		if(timer->slot == APE_SCHED_RUNNING){
+			if(timer->period > 0){
+				APE_SCHED_insert(timer,timer->period);
+			}else{
+				timer->slot = APE_SCHED_STOPPED;
+			}
+		}
+	}
+}
+
+/**
+  * @brief  serve gli eventi presenti nelle code delle tabelle
+  * @retval numero di eventi serviti
+  */
+static uint32_t APE_SCHED_drain(void){
+	uint32_t served = 0;
+	uint64_t latency;
+	gpio_it_t* src;
+	int i;
+
+	for(i = 0; i < APE_SCHED_numSources; i++){
+		src = APE_SCHED_sources[i];
+		while(APE_RING_pop(src->ring,&src->event)){
+			latency = APE_RING_timestamp() - src->event.timestamp;
+			if(latency > APE_SCHED_stats.max_latency){
+				APE_SCHED_stats.max_latency = latency;
+			}
+			APE_IT_dispatch(src,src->event.pending);
+			served++;
+		}
+	}
+	APE_SCHED_stats.events += served;
+	return served;
+}
+
+/**
+  * @brief  verifica se c'e' lavoro da svolgere
+  * @retval true se ci sono tick da elaborare o eventi in coda
+  */
+static bool APE_SCHED_busy(void){
+	int i;
+
+	if(APE_SCHED_ticks != APE_SCHED_now){
+		return true;
+	}
+	for(i = 0; i < APE_SCHED_numSources; i++){
+		if(!APE_RING_empty(APE_SCHED_sources[i]->ring)){
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+  * @brief  inizializza lo scheduler senza timer ne' sorgenti
+  * @retval None
+  */
+void APE_SCHED_Init(void){
+	int i;
+
+	for(i = 0; i < APE_SCHED_WHEEL_SLOTS; i++){
+		APE_SCHED_wheel[i] = NULL;
+	}
+	APE_SCHED_expired = NULL;
+	APE_SCHED_now = 0;
+	APE_SCHED_ticks = 0;
+	APE_SCHED_numSources = 0;
+	APE_SCHED_stats.wakeups = 0;
+	APE_SCHED_stats.events = 0;
+	APE_SCHED_stats.max_latency = 0;
+}
+
+/**
+  * @brief  aggiunge una tabella alle sorgenti servite dallo scheduler
+  * @param 	source: tabella a cui e' gia' associata una coda (APE_IT_setRing)
+  * @retval true se la tabella e' stata aggiunta, false se non ha una coda
+  * 		o le sorgenti sono esaurite
+  */
+bool APE_SCHED_addSource(gpio_it_t* source){
+	if(source->ring == NULL || APE_SCHED_numSources >= APE_SCHED_MAX_SOURCES){
+		return false;
+	}
+	APE_SCHED_sources[APE_SCHED_numSources++] = source;
+	return true;
+}
+
+/**
+  * @brief  avvia un timer, fermandolo se gia' attivo
+  * @param 	timer: puntatore al timer
+  * @param 	callback: funzione invocata alla scadenza, nel contesto di APE_SCHED_run
+  * @param 	context: argomento passato alla funzione
+  * @param 	delay: tick alla prima scadenza (0 equivale a 1)
+  * @param 	period: periodo in tick, 0 per un timer singolo
+  * @retval None
+  */
+void APE_SCHED_startTimer(sched_timer_t* timer,void (*callback)(void*),void* context,uint32_t delay,uint32_t period){
+	APE_SCHED_stopTimer(timer);
+	timer->callback = callback;
+	timer->context = context;
+	timer->period = period;
+	APE_SCHED_insert(timer,(delay == 0) ? 1 : delay);
+}
+
+/**
+  * @brief  ferma un timer, anche se scaduto e non ancora servito
+  * @param 	timer: puntatore al timer, deve essere stato azzerato o avviato
+  * @retval None
+  */
+void APE_SCHED_stopTimer(sched_timer_t* timer){
+	if(timer->pprev != NULL){
+		APE_SCHED_unlink(timer);
+	}
+	timer->slot = APE_SCHED_STOPPED;
+}
+
+/**
+  * @brief  conta un tick, da chiamare nella IRQ Handler del timer periodico
+  * @retval None
+  */
+void APE_SCHED_tick(void){
+	APE_SCHED_ticks++;
+}
+
+/**
+  * @brief  esegue un ciclo dello scheduler: serve gli eventi GPIO e i timer
+  * 		scaduti, poi attende in WFI la successiva interrupt
+  * @retval None
+  */
+void APE_SCHED_run(void){
+	APE_SCHED_drain();
+
+	while(APE_SCHED_now != APE_SCHED_ticks){
+		APE_SCHED_advance();
+		APE_SCHED_drain();
+	}
+
+	APE_SCHED_IRQ_DISABLE();
+	if(!APE_SCHED_busy()){
+		APE_SCHED_WAIT();
+		APE_SCHED_stats.wakeups++;
+	}
+	APE_SCHED_IRQ_ENABLE();
+}
+
+/**
+  * @brief  restituisce le statistiche dello scheduler
+  * @retval puntatore alle statistiche
+  */
+const sched_stats_t* APE_SCHED_getStats(void){
+	return &APE_SCHED_stats;
+}
+/**@}*/
+/**@}*/
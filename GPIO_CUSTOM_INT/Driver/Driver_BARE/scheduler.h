@@ -0,0 +1,86 @@
+/**
+  ******************************************************************************
+  * @file    scheduler.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce lo scheduler ad eventi del driver
+  * 		 BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup BARE_METAL
+  * @{
+  * @brief   Scheduler ad eventi con attesa in WFI e timer software.
+  * @details Il programma principale chiama APE_SCHED_run, che:
+  * 		 - serve gli eventi GPIO registrati nelle code delle tabelle
+  * 		   aggiunte con APE_SCHED_addSource (vedi APE_IT_drain);
+  * 		 - avanza la timer wheel di tanti tick quanti ne ha contati
+  * 		   APE_SCHED_tick, chiamata dalla IRQ Handler di un timer periodico,
+  * 		   e invoca le callback dei timer scaduti (es. debounce, lampeggio);
+  * 		 - se non c'e' altro lavoro sospende la CPU con WFI fino alla
+  * 		   successiva interrupt del GIC.
+  * 		 La verifica di assenza di lavoro e la WFI avvengono con le IRQ
+  * 		 mascherate: una interrupt arrivata nel frattempo resta pendente e
+  * 		 risveglia comunque la CPU, quindi non puo' essere persa.
+  * 		 La timer wheel ha APE_SCHED_WHEEL_SLOTS posizioni: avviare o fermare
+  * 		 un timer ha costo costante (liste doppiamente collegate) e ad ogni
+  * 		 tick e' visitata una sola posizione.
+  * 		 Le callback possono avviare o fermare qualunque timer, anche uno
+  * 		 scaduto nello stesso tick e non ancora servito: fermato non viene
+  * 		 invocato, riavviato scade secondo il nuovo ritardo. Un timer
+  * 		 periodico e' reinserito dopo la callback solo se questa non lo ha
+  * 		 fermato o riavviato.
+  ******************************************************************************
+  */
+#ifndef SRC_SCHEDULER_H_
+#define SRC_SCHEDULER_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_it.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define APE_SCHED_WHEEL_SLOTS	16	/*!< posizioni della timer wheel, potenza di due*/
+#define APE_SCHED_MAX_SOURCES	4	/*!< numero massimo di tabelle gpio_it_t servite*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief tipo sched_timer_t
+  */
+typedef struct sched_timer_t sched_timer_t;
+
+/**
+  * @brief timer software gestito dalla timer wheel
+  */
+struct sched_timer_t{
+	void (*callback)(void* context);	/*!< funzione invocata alla scadenza*/
+	void* context;						/*!< argomento passato alla funzione*/
+	uint32_t period;					/*!< periodo in tick, 0 per un timer singolo*/
+	uint32_t rounds;					/*!< giri completi della wheel prima della scadenza*/
+	int slot;							/*!< posizione nella wheel, negativo se fermo, scaduto o in esecuzione*/
+	sched_timer_t* next;				/*!< timer successivo nella stessa lista*/
+	sched_timer_t** pprev;				/*!< puntatore che punta al timer nella lista, NULL se fuori lista*/
+};
+
+/**
+  * @brief statistiche dello scheduler
+  */
+typedef struct {
+	uint32_t wakeups;		/*!< risvegli dalla WFI*/
+	uint32_t events;		/*!< eventi GPIO serviti*/
+	uint64_t max_latency;	/*!< massimo ritardo tra interrupt e dispatch, in cicli del global timer*/
+} sched_stats_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+void APE_SCHED_Init(void);
+bool APE_SCHED_addSource(gpio_it_t*);
+void APE_SCHED_startTimer(sched_timer_t*,void (*)(void*),void*,uint32_t,uint32_t);
+void APE_SCHED_stopTimer(sched_timer_t*);
+void APE_SCHED_tick(void);
+void APE_SCHED_run(void);
+const sched_stats_t* APE_SCHED_getStats(void);
+
+#endif /* SRC_SCHEDULER_H_ */
+/**@}*/
+/**@}*/
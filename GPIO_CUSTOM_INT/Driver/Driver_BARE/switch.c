@@ -22,12 +22,7 @@
   * @retval	None
   */
 void SW_enable(switch_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DIR_REG);
-	uint32_t mask = SW_ALL_MASK;
-
-	mask = mask | status;
-
-	APE_writeValue32(self->base_addr,APE_DIR_REG,mask);
+	APE_SHADOW_update(self->base_addr,APE_DIR_REG,SW_ALL_MASK,0);
 }
 
 /**
@@ -36,12 +31,7 @@ void SW_enable(switch_t* self){
   * @retval	None
   */
 void SW_disable(switch_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DIR_REG);
-	uint32_t mask = ~SW_ALL_MASK;
-
-	mask = mask & status;
-
-	APE_writeValue32(self->base_addr,APE_DIR_REG,mask);
+	APE_SHADOW_update(self->base_addr,APE_DIR_REG,0,SW_ALL_MASK);
 }
 
 /**
@@ -50,7 +40,7 @@ void SW_disable(switch_t* self){
   * @retval	il valore del nibble del registro dato su cui sono mappati gli switch
   */
 uint32_t SW_readStatus(switch_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DATA_REG);
+	uint32_t status = APE_READ32(self->base_addr,APE_DATA_REG);
 	status = (status & SW_ALL_MASK);
 	return (status >> SW_NIBBLE_OFFSET);
 }
@@ -61,7 +51,7 @@ uint32_t SW_readStatus(switch_t* self){
   * @retval	lo stato dello switch (true/false)
   */
 switch_state SW_readSwitch(switch_t* self,switch_n sw_num){
-	uint32_t status = APE_readValue32(self->base_addr,APE_DATA_REG);
+	uint32_t status = APE_READ32(self->base_addr,APE_DATA_REG);
 	status = (status & (0x1 << sw_num));
 	return (status >> sw_num);
 }
@@ -78,29 +68,18 @@ switch_state SW_readSwitch(switch_t* self,switch_n sw_num){
   * @retval	None
   */
 void SW_enableInterrupt(switch_t* self,uint32_t int_mask,interrupt_mode mode){
-
-	uint32_t status;
 	uint32_t mask = int_mask << SW_NIBBLE_OFFSET;
 
 	switch (mode){
 	case INT_RISING:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,mask,0);
 		break;
 	case INT_FALLING:
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,mask,0);
 		break;
 	case INT_RIS_FALL:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
-
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask | status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,mask,0);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,mask,0);
 		break;
 	}
 }
@@ -117,29 +96,18 @@ void SW_enableInterrupt(switch_t* self,uint32_t int_mask,interrupt_mode mode){
   * @retval	None
   */
 void SW_disableInterrupt(switch_t* self,uint32_t int_mask,interrupt_mode mode){
-	uint32_t status;
 	uint32_t mask = int_mask << SW_NIBBLE_OFFSET;
-	mask = ~mask;
 
 	switch (mode){
 	case INT_RISING:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,0,mask);
 		break;
 	case INT_FALLING:
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,0,mask);
 		break;
 	case INT_RIS_FALL:
-		status = APE_readValue32(self->base_addr,APE_IERR_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERR_REG,mask);
-
-		status = APE_readValue32(self->base_addr,APE_IERF_REG);
-		mask = mask & status;
-		APE_writeValue32(self->base_addr,APE_IERF_REG,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERR_REG,0,mask);
+		APE_SHADOW_update(self->base_addr,APE_IERF_REG,0,mask);
 		break;
 	}
 }
@@ -150,7 +118,7 @@ void SW_disableInterrupt(switch_t* self,uint32_t int_mask,interrupt_mode mode){
   * @retval	il valore del nibble del registro ISR su cui sono mappate le interrupt degli switch
   */
 uint32_t SW_readISR(switch_t* self){
-	uint32_t status = APE_readValue32(self->base_addr,APE_ICRISR_REG);
+	uint32_t status = APE_READ32(self->base_addr,APE_ICRISR_REG);
 	status = (status & SW_ALL_MASK);
 	return (status >> SW_NIBBLE_OFFSET);
 }
@@ -162,12 +130,46 @@ uint32_t SW_readISR(switch_t* self){
   * @retval	None
   */
 void SW_clearISR(switch_t* self,uint32_t int_mask){
-	uint32_t ISR_value = APE_readValue32(self->base_addr,APE_ICRISR_REG);
+	uint32_t ISR_value = APE_READ32(self->base_addr,APE_ICRISR_REG);
 	uint32_t mask = int_mask & (ISR_value >> SW_NIBBLE_OFFSET);
 
 	mask = mask << SW_NIBBLE_OFFSET;
 
-	APE_writeValue32(self->base_addr,APE_ICRISR_REG,mask);
+	APE_WRITE32(self->base_addr,APE_ICRISR_REG,mask);
+}
+
+/**
+  * @brief  estrae il valore degli switch da una fotografia della periferica
+  * @param 	self: puntatore alla struttura
+  * @param 	snap: fotografia acquisita con APE_SNAP_capture
+  * @retval	il valore del nibble del registro dato su cui sono mappati degli switch
+  */
+uint32_t SW_decodeStatus(switch_t* self,const gpio_snapshot_t* snap){
+	(void)self;
+	return (snap->data & SW_ALL_MASK) >> SW_NIBBLE_OFFSET;
+}
+
+/**
+  * @brief  estrae il valore di uno switch da una fotografia della periferica
+  * @param 	self: puntatore alla struttura
+  * @param 	snap: fotografia acquisita con APE_SNAP_capture
+  * @param 	sw_num: posizione dello switch
+  * @retval	lo stato dello switch (true/false)
+  */
+switch_state SW_decodeSwitch(switch_t* self,const gpio_snapshot_t* snap,switch_n sw_num){
+	(void)self;
+	return (switch_state)((snap->data >> sw_num) & 0x1);
+}
+
+/**
+  * @brief  estrae le interrupt degli switch da una fotografia della periferica
+  * @param 	self: puntatore alla struttura
+  * @param 	snap: fotografia acquisita con APE_SNAP_captureAll
+  * @retval	il valore del nibble del registro ISR su cui sono mappate le interrupt degli switch
+  */
+uint32_t SW_decodeISR(switch_t* self,const gpio_snapshot_t* snap){
+	(void)self;
+	return (snap->isr & SW_ALL_MASK) >> SW_NIBBLE_OFFSET;
 }
 
 /**
@@ -224,6 +226,9 @@ void SW_Init(switch_t* self){
 	self->enable = &SW_enable;
 	self->disable = &SW_disable;
 	self->readStatus = &SW_readStatus;
+	self->decodeStatus = &SW_decodeStatus;
+	self->decodeSwitch = &SW_decodeSwitch;
+	self->decodeISR = &SW_decodeISR;
 	self->readSwitch = &SW_readSwitch;
 	self->enableInterrupt = &SW_enableInterrupt;
 	self->disableInterrupt = &SW_disableInterrupt;
@@ -18,7 +18,9 @@
 #define SRC_SWITCH_H_
 
 /* Includes ------------------------------------------------------------------*/
-#include "gpio_LL.h"
+#include "gpio_LL_inline.h"
+#include "gpio_shadow.h"
+#include "gpio_snapshot.h"
 #include "defines.h"
 
 /* Macro ---------------------------------------------------------------------*/
@@ -65,6 +67,9 @@ struct switch_t{
 	void (*enable)(switch_t* self);
 	void (*disable)(switch_t* self);
 	uint32_t (*readStatus)(switch_t* self);
+	uint32_t (*decodeStatus)(switch_t* self,const gpio_snapshot_t* snap);
+	switch_state (*decodeSwitch)(switch_t* self,const gpio_snapshot_t* snap,switch_n);
+	uint32_t (*decodeISR)(switch_t* self,const gpio_snapshot_t* snap);
 	switch_state (*readSwitch)(switch_t* self,switch_n);
 	void (*enableInterrupt)(switch_t*,uint32_t ,interrupt_mode);
 	void (*disableInterrupt)(switch_t*,uint32_t ,interrupt_mode);
@@ -78,6 +83,15 @@ struct switch_t{
  */
 void SW_Init(switch_t*);
 
+/**
+  * @brief firme delle callback, definite deboli nel modulo e invocate
+  * 		dalla tabella di dispatch predefinita di gpio_it.c
+ */
+void APE_SW0_Callback(void);
+void APE_SW1_Callback(void);
+void APE_SW2_Callback(void);
+void APE_SW3_Callback(void);
+
 #endif /* SRC_SWITCH_H_ */
 /**@}*/
 /**@}*/
\ No newline at end of file
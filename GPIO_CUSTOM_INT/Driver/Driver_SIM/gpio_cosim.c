@@ -0,0 +1,249 @@
+/**
+  ******************************************************************************
+  * @file    gpio_cosim.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa il backend di co-simulazione del driver SIM
+  * 		 con la simulazione GHDL di APE_GPIO_TOP.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "gpio_cosim.h"
+
+/**
+  * @brief  trasferisce un buffer completo sul canale, ripetendo le
+  * 		operazioni parziali
+  * @param 	fd: descrittore del canale
+  * @param 	buf: buffer
+  * @param 	len: byte da trasferire
+  * @param 	out: 1 per scrivere, 0 per leggere
+  *	@retval 0 in caso di successo, -1 altrimenti
+  */
+static int COSIM_xfer(int fd,void* buf,size_t len,int out){
+	char* p = buf;
+
+	while(len > 0){
+		ssize_t n = out ? write(fd,p,len) : read(fd,p,len);
+
+		if(n < 0 && errno == EINTR){
+			continue;
+		}
+		if(n <= 0){
+			return -1;
+		}
+		p += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/**
+  * @brief  esegue un'operazione sul simulatore e ne attende la risposta,
+  * 		poi consegna l'eventuale asserzione di gpio_int. Un errore del
+  * 		canale termina il processo: il driver non ha altro modo di
+  * 		riportarlo da un accesso ai registri.
+  * @param 	self: puntatore al collegamento
+  * @param 	req: richiesta
+  *	@retval la risposta del simulatore
+  */
+static cosim_rsp_t COSIM_transaction(COSIM_gpio_t* self,cosim_req_t req){
+	cosim_rsp_t rsp;
+
+	if(COSIM_xfer(self->fd,&req,sizeof(req),1) < 0 ||
+	   COSIM_xfer(self->fd,&rsp,sizeof(rsp),0) < 0){
+		fprintf(stderr,"cosim: simulatore non raggiungibile\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if(rsp.irq && !self->irq){
+		self->irq_pending = true;
+	}
+	self->irq = rsp.irq;
+
+	/* Gli accessi dell'handler passano di qui: la consegna non e' annidata */
+	if(self->irq_pending && !self->in_irq){
+		self->in_irq = true;
+		while(self->irq_pending){
+			self->irq_pending = false;
+			self->irqs++;
+			APE_busIRQ();
+		}
+		self->in_irq = false;
+	}
+	return rsp;
+}
+
+/**
+  * @brief  avvia il simulatore collegandolo al driver
+  * @param 	self: puntatore al collegamento
+  * @param 	argv: eseguibile di simulazione e relativi argomenti, terminati
+  * 		da NULL
+  *	@retval 0 in caso di successo, -1 altrimenti
+  */
+int COSIM_Init(COSIM_gpio_t* self,char* const argv[]){
+	int sv[2];
+	char fd_str[16];
+
+	*self = (COSIM_gpio_t){ .fd = -1, .pid = -1 };
+
+	if(socketpair(AF_UNIX,SOCK_STREAM | SOCK_CLOEXEC,0,sv) < 0){
+		perror("socketpair");
+		return -1;
+	}
+
+	self->pid = fork();
+	if(self->pid < 0){
+		perror("fork");
+		close(sv[0]);
+		close(sv[1]);
+		return -1;
+	}
+	if(self->pid == 0){
+		/* Simulatore: l'estremita' sv[1] resta aperta dopo la exec */
+		fcntl(sv[1],F_SETFD,0);
+		snprintf(fd_str,sizeof(fd_str),"%d",sv[1]);
+		setenv(COSIM_FD_ENV,fd_str,1);
+		execvp(argv[0],argv);
+		perror(argv[0]);
+		_exit(127);
+	}
+
+	close(sv[1]);
+	self->fd = sv[0];
+	return 0;
+}
+
+/**
+  * @brief  registra il simulatore come backend del driver SIM. Le interrupt
+  * 		sono consegnate all'handler registrato con APE_setBusIRQHandler.
+  * @param 	self: puntatore al collegamento
+  *	@retval None
+  */
+void COSIM_attach(COSIM_gpio_t* self){
+	APE_bus_t backend;
+
+	backend.read = &COSIM_read;
+	backend.write = &COSIM_write;
+	backend.ctx = self;
+	APE_setBus(&backend);
+}
+
+/**
+  * @brief  lettura AXI di un registro, firma compatibile con APE_bus_t
+  * @param 	ctx: puntatore al collegamento
+  * @param 	addr: indirizzo base della periferica (ignorato)
+  * @param  offset: offset del registro
+  *	@retval il valore letto
+  */
+uint32_t COSIM_read(void* ctx,uint32_t* addr,int offset){
+	COSIM_gpio_t* self = ctx;
+	cosim_rsp_t rsp;
+	(void)addr;
+
+	rsp = COSIM_transaction(self,(cosim_req_t){ COSIM_OP_READ, offset, 0, 0 });
+	self->reads++;
+	self->read_cycles += rsp.cycles;
+	return rsp.value;
+}
+
+/**
+  * @brief  scrittura AXI di un registro, firma compatibile con APE_bus_t
+  * @param 	ctx: puntatore al collegamento
+  * @param 	addr: indirizzo base della periferica (ignorato)
+  * @param  offset: offset del registro
+  * @param 	value: valore da scrivere
+  * @param 	strb: byte lane da aggiornare (S_AXI_WSTRB)
+  *	@retval None
+  */
+void COSIM_write(void* ctx,uint32_t* addr,int offset,uint32_t value,uint8_t strb){
+	COSIM_gpio_t* self = ctx;
+	cosim_rsp_t rsp;
+	(void)addr;
+
+	rsp = COSIM_transaction(self,(cosim_req_t){ COSIM_OP_WRITE, offset, value, strb });
+	self->writes++;
+	self->write_cycles += rsp.cycles;
+}
+
+/**
+  * @brief  impone il livello dei pad selezionati e attende che gli
+  * 		eventuali fronti siano registrati in ISR
+  * @param 	self: puntatore al collegamento
+  * @param 	mask: pad da pilotare
+  * @param 	value: livello dei pad selezionati
+  *	@retval None
+  */
+void COSIM_setPads(COSIM_gpio_t* self,uint32_t mask,uint32_t value){
+	cosim_rsp_t rsp;
+
+	rsp = COSIM_transaction(self,(cosim_req_t){ COSIM_OP_PADS, 0, value, mask });
+	self->other_cycles += rsp.cycles;
+}
+
+/**
+  * @brief  impone il livello di un pad
+  * @param 	self: puntatore al collegamento
+  * @param 	pin: posizione del pad
+  * @param 	value: livello
+  *	@retval None
+  */
+void COSIM_setPin(COSIM_gpio_t* self,int pin,bool value){
+	COSIM_setPads(self,0x1u << pin,value ? (0x1u << pin) : 0);
+}
+
+/**
+  * @brief  lascia avanzare la simulazione senza accessi al bus
+  * @param 	self: puntatore al collegamento
+  * @param 	cycles: cicli di clock da attendere
+  *	@retval None
+  */
+void COSIM_idle(COSIM_gpio_t* self,uint32_t cycles){
+	cosim_rsp_t rsp;
+
+	rsp = COSIM_transaction(self,(cosim_req_t){ COSIM_OP_IDLE, 0, cycles, 0 });
+	self->other_cycles += rsp.cycles;
+}
+
+/**
+  * @brief  termina la simulazione e ne attende l'uscita
+  * @param 	self: puntatore al collegamento
+  *	@retval lo stato di uscita del simulatore, -1 in caso di errore
+  */
+int COSIM_close(COSIM_gpio_t* self){
+	cosim_req_t req = { COSIM_OP_END, 0, 0, 0 };
+	cosim_rsp_t rsp;
+	int status;
+
+	if(self->pid < 0){
+		return -1;
+	}
+	if(COSIM_xfer(self->fd,&req,sizeof(req),1) == 0){
+		COSIM_xfer(self->fd,&rsp,sizeof(rsp),0);
+	}
+	close(self->fd);
+	self->fd = -1;
+
+	while(waitpid(self->pid,&status,0) < 0){
+		if(errno != EINTR){
+			return -1;
+		}
+	}
+	self->pid = -1;
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+/**@}*/
+/**@}*/
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    gpio_cosim.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce il backend di co-simulazione del driver SIM
+  * 		 con la simulazione GHDL di APE_GPIO_TOP.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Backend di bus collegato all'RTL della periferica.
+  * @details COSIM_Init avvia l'eseguibile di simulazione (VHDL/tb/APE_GPIO_cosim.vhd
+  * 		 elaborato con la libreria VHPIDIRECT APE_GPIO_cosim_vhpi.c) e gli passa
+  * 		 un'estremita' di una socketpair nella variabile d'ambiente APE_COSIM_FD.
+  * 		 Con COSIM_attach ogni accesso ai registri del driver diventa una
+  * 		 transazione AXI4-Lite eseguita dal modello funzionale del bus nel
+  * 		 testbench, in lockstep: il tempo simulato avanza solo durante le
+  * 		 richieste del driver.
+  * 		 La linea gpio_int dell'RTL e' riportata in ogni risposta: quando passa
+  * 		 da '0' a '1' il backend invoca APE_busIRQ, come l'emulatore. Un fronte
+  * 		 che arriva mentre l'handler e' in esecuzione viene consegnato al suo
+  * 		 ritorno.
+  * 		 Il backend conta letture, scritture, interrupt e cicli di clock
+  * 		 simulati per tipo di operazione.
+  * 		 I pad vanno pilotati con COSIM_setPads solo sui pin in ingresso: su un
+  * 		 pin in uscita il valore imposto va in conflitto con quello della
+  * 		 periferica ('X'). I pad non pilotati sono a '0' debole.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_COSIM_H_
+#define SRC_GPIO_COSIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <sys/types.h>
+#include "gpio_LL.h"
+#include "gpio_cosim_proto.h"
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief stato del collegamento con il simulatore
+  */
+typedef struct {
+	int fd;					/*!< estremita' della socketpair lato driver*/
+	pid_t pid;				/*!< processo del simulatore*/
+	uint32_t irq;			/*!< ultimo livello di gpio_int riportato*/
+	bool irq_pending;		/*!< asserzione di gpio_int da consegnare*/
+	bool in_irq;			/*!< handler di interrupt in esecuzione*/
+	uint32_t reads;			/*!< letture effettuate sul bus*/
+	uint32_t writes;		/*!< scritture effettuate sul bus*/
+	uint32_t irqs;			/*!< interrupt consegnate*/
+	uint64_t read_cycles;	/*!< cicli di clock delle letture*/
+	uint64_t write_cycles;	/*!< cicli di clock delle scritture*/
+	uint64_t other_cycles;	/*!< cicli di clock di pad e attese*/
+} COSIM_gpio_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+int COSIM_Init(COSIM_gpio_t*,char* const[]);
+void COSIM_attach(COSIM_gpio_t*);
+uint32_t COSIM_read(void*,uint32_t*,int);
+void COSIM_write(void*,uint32_t*,int,uint32_t,uint8_t);
+void COSIM_setPads(COSIM_gpio_t*,uint32_t,uint32_t);
+void COSIM_setPin(COSIM_gpio_t*,int,bool);
+void COSIM_idle(COSIM_gpio_t*,uint32_t);
+int COSIM_close(COSIM_gpio_t*);
+
+#endif /* SRC_GPIO_COSIM_H_ */
+/**@}*/
+/**@}*/
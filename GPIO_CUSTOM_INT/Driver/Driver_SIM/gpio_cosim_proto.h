@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    gpio_cosim_proto.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce i messaggi scambiati tra il driver SIM e la
+  * 		 simulazione GHDL di APE_GPIO_TOP.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Protocollo della co-simulazione.
+  * @details Il driver invia una richiesta alla volta e attende la risposta:
+  * 		 mentre il driver elabora, il tempo simulato e' fermo.
+  * 		 Ogni risposta riporta i cicli di clock consumati dall'operazione e il
+  * 		 livello di gpio_int al suo termine.
+  * 		 Il file e' incluso sia dal driver (gpio_cosim.c) sia dalla libreria
+  * 		 VHPIDIRECT collegata al simulatore (VHDL/tb/APE_GPIO_cosim_vhpi.c),
+  * 		 pertanto non dipende da altri file del driver.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_COSIM_PROTO_H_
+#define SRC_GPIO_COSIM_PROTO_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macro ---------------------------------------------------------------------*/
+#define COSIM_FD_ENV	"APE_COSIM_FD"	/*!< variabile d'ambiente con il descrittore del canale*/
+
+/**
+  * @brief operazioni richieste al simulatore
+  */
+#define COSIM_OP_READ	0	/*!< lettura AXI del registro offset*/
+#define COSIM_OP_WRITE	1	/*!< scrittura AXI di value sul registro offset, WSTRB = mask*/
+#define COSIM_OP_PADS	2	/*!< i pad selezionati da mask assumono il livello di value*/
+#define COSIM_OP_IDLE	3	/*!< attesa di value cicli di clock*/
+#define COSIM_OP_END	4	/*!< fine della simulazione*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief richiesta del driver al simulatore
+  */
+typedef struct {
+	uint32_t op;		/*!< operazione (COSIM_OP_xxx)*/
+	uint32_t offset;	/*!< offset del registro*/
+	uint32_t value;		/*!< dato, livello dei pad o numero di cicli*/
+	uint32_t mask;		/*!< WSTRB o maschera dei pad*/
+} cosim_req_t;
+
+/**
+  * @brief risposta del simulatore al driver
+  */
+typedef struct {
+	uint32_t value;		/*!< dato letto (solo COSIM_OP_READ)*/
+	uint32_t cycles;	/*!< cicli di clock consumati dall'operazione*/
+	uint32_t irq;		/*!< livello di gpio_int al termine dell'operazione*/
+} cosim_rsp_t;
+
+#endif /* SRC_GPIO_COSIM_PROTO_H_ */
+/**@}*/
+/**@}*/
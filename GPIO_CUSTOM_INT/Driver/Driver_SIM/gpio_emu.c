@@ -0,0 +1,252 @@
+/**
+  ******************************************************************************
+  * @file    gpio_emu.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa l'emulatore a livello registri della
+  * 		 periferica APE_GPIO usato dal driver SIM.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "gpio_emu.h"
+
+/**
+  * @brief  ricalcola il valore letto dal gpio_array e registra in ISR i
+  * 		fronti abilitati, come fanno edge_detector e ICRISR_management
+  * @param 	self: puntatore all'emulatore
+  *	@retval None
+  */
+static void EMU_update(EMU_gpio_t* self){
+	uint32_t read = ((self->pads & self->dir) | (self->data & ~self->dir)) & self->width_mask;
+	uint32_t changed = read ^ self->read;
+	uint32_t edges;
+	uint32_t isr;
+
+	self->read = read;
+	if(changed == 0){
+		return;
+	}
+
+	/* Fronti di salita e discesa abilitati, solo sui pin in ingresso */
+	edges = ((changed & read & self->ierr) | (changed & ~read & self->ierf)) & self->dir;
+	isr = self->isr | edges;
+
+	/* gpio_int passa da '0' a '1' */
+	if(self->isr == 0 && isr != 0){
+		self->isr = isr;
+		self->irqs++;
+		if(self->irq_callback != NULL){
+			self->irq_callback(self->irq_arg);
+		}
+	}else{
+		self->isr = isr;
+	}
+}
+
+/**
+  * @brief  inizializza l'emulatore con tutti i registri azzerati, come
+  * 		dopo il reset della periferica
+  * @param 	self: puntatore all'emulatore
+  * @param 	width: numero di pin implementati (generic width)
+  *	@retval None
+  */
+void EMU_Init(EMU_gpio_t* self,int width){
+	self->data = 0;
+	self->dir = 0;
+	self->ierr = 0;
+	self->ierf = 0;
+	self->isr = 0;
+	self->pads = 0;
+	self->read = 0;
+	self->width_mask = (width >= 32) ? 0xFFFFFFFF : ((0x1u << width) - 1);
+	self->irq_callback = NULL;
+	self->irq_arg = NULL;
+	self->reads = 0;
+	self->writes = 0;
+	self->irqs = 0;
+}
+
+#ifdef DRIVER_SIM
+/**
+  * @brief  inoltra l'asserzione di gpio_int al driver SIM
+  */
+static void EMU_busIRQ(void* arg){
+	(void)arg;
+	APE_busIRQ();
+}
+
+/**
+  * @brief  registra l'emulatore come backend del driver SIM. Le interrupt
+  * 		sono consegnate all'handler registrato con APE_setBusIRQHandler.
+  * @param 	self: puntatore all'emulatore
+  *	@retval None
+  */
+void EMU_attach(EMU_gpio_t* self){
+	APE_bus_t backend;
+
+	backend.read = &EMU_read;
+	backend.write = &EMU_write;
+	backend.ctx = self;
+	APE_setBus(&backend);
+
+	EMU_setIRQCallback(self,&EMU_busIRQ,NULL);
+}
+#endif /* DRIVER_SIM */
+
+/**
+  * @brief  imposta la callback invocata all'asserzione di gpio_int
+  * @param 	self: puntatore all'emulatore
+  * @param 	callback: funzione da invocare
+  * @param 	arg: argomento passato alla funzione
+  *	@retval None
+  */
+void EMU_setIRQCallback(EMU_gpio_t* self,void (*callback)(void*),void* arg){
+	self->irq_callback = callback;
+	self->irq_arg = arg;
+}
+
+/**
+  * @brief  lettura di un registro, firma compatibile con APE_bus_t
+  * @param 	ctx: puntatore all'emulatore
+  * @param 	addr: indirizzo base della periferica (ignorato)
+  * @param  offset: offset del registro
+  *	@retval il valore del registro
+  */
+uint32_t EMU_read(void* ctx,uint32_t* addr,int offset){
+	EMU_gpio_t* self = ctx;
+	(void)addr;
+
+	self->reads++;
+	switch(offset){
+	case APE_DATA_REG:
+		return self->read;
+	case APE_DIR_REG:
+		return self->dir;
+	case APE_IERR_REG:
+		return self->ierr;
+	case APE_IERF_REG:
+		return self->ierf;
+	case APE_ICRISR_REG:
+		return self->isr;
+	default:
+		return 0;
+	}
+}
+
+/**
+  * @brief  scrittura di un registro, firma compatibile con APE_bus_t
+  * @param 	ctx: puntatore all'emulatore
+  * @param 	addr: indirizzo base della periferica (ignorato)
+  * @param  offset: offset del registro
+  * @param 	value: valore da scrivere
+  * @param 	strb: byte lane da aggiornare, come S_AXI_WSTRB
+  *	@retval None
+  */
+void EMU_write(void* ctx,uint32_t* addr,int offset,uint32_t value,uint8_t strb){
+	EMU_gpio_t* self = ctx;
+	uint32_t lanes = 0;
+	int i;
+	(void)addr;
+
+	for(i = 0; i < 4; i++){
+		if(strb & (0x1 << i)){
+			lanes |= 0xFFu << (8*i);
+		}
+	}
+
+	self->writes++;
+	switch(offset){
+	case APE_DATA_REG:
+		self->data = (self->data & ~lanes) | (value & lanes);
+		break;
+	case APE_DIR_REG:
+		self->dir = (self->dir & ~lanes) | (value & lanes);
+		break;
+	case APE_IERR_REG:
+		self->ierr = (self->ierr & ~lanes) | (value & lanes);
+		break;
+	case APE_IERF_REG:
+		self->ierf = (self->ierf & ~lanes) | (value & lanes);
+		break;
+	case APE_ICRISR_REG:
+		/* ICR: scrivere '1' azzera il bit pendente, scrivere '0' e' ininfluente */
+		self->isr &= ~(value & lanes);
+		return;
+	default:
+		return;
+	}
+
+	EMU_update(self);
+}
+
+/**
+  * @brief  impone un livello sui pad selezionati da una maschera
+  * @param 	self: puntatore all'emulatore
+  * @param 	mask: maschera dei pad da pilotare
+  * @param 	value: livello dei pad selezionati
+  *	@retval None
+  */
+void EMU_setPads(EMU_gpio_t* self,uint32_t mask,uint32_t value){
+	self->pads = (self->pads & ~mask) | (value & mask);
+	EMU_update(self);
+}
+
+/**
+  * @brief  impone un livello su un singolo pad
+  * @param 	self: puntatore all'emulatore
+  * @param 	pos: posizione del pad
+  * @param 	val: livello da imporre
+  *	@retval None
+  */
+void EMU_setPin(EMU_gpio_t* self,int pos,bool val){
+	EMU_setPads(self,0x1u << pos,val ? 0xFFFFFFFF : 0x0);
+}
+
+/**
+  * @brief  inverte il livello dei pad selezionati da una maschera
+  * @param 	self: puntatore all'emulatore
+  * @param 	mask: maschera dei pad da invertire
+  *	@retval None
+  */
+void EMU_togglePins(EMU_gpio_t* self,uint32_t mask){
+	self->pads ^= mask;
+	EMU_update(self);
+}
+
+/**
+  * @brief  legge il livello presente sui pad, pilotati dall'esterno
+  * 		se in ingresso o dal registro DATA se in uscita
+  * @param 	self: puntatore all'emulatore
+  *	@retval il valore dei pad
+  */
+uint32_t EMU_readPads(EMU_gpio_t* self){
+	return self->read;
+}
+
+/**
+  * @brief  esegue uno script di stimolo, applicando i passi in sequenza
+  * @param 	self: puntatore all'emulatore
+  * @param 	script: vettore dei passi
+  * @param 	steps: numero di passi dello script
+  * @param 	repeat: numero di ripetizioni dell'intero script
+  *	@retval None
+  */
+void EMU_runScript(EMU_gpio_t* self,const EMU_step_t* script,int steps,int repeat){
+	int i;
+
+	while(repeat-- > 0){
+		for(i = 0; i < steps; i++){
+			EMU_setPads(self,script[i].mask,script[i].value);
+		}
+	}
+}
+/**@}*/
+/**@}*/
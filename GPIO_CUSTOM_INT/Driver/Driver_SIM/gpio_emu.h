@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    gpio_emu.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce l'emulatore a livello registri della
+  * 		 periferica APE_GPIO usato dal driver SIM.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Emulatore in-process della periferica APE_GPIO.
+  * @details L'emulatore riproduce il comportamento del blocco registri
+  * 		 descritto in APE_GPIO_AXI.vhd:
+  * 		 - DATA in lettura restituisce il valore dei pad per i pin con DIR a '1'
+  * 		   e il latch di scrittura per i pin con DIR a '0'.
+  * 		 - I fronti sono rilevati sul valore letto e registrati in ISR solo per
+  * 		   i pin in ingresso (DIR a '1') abilitati in IERR/IERF.
+  * 		 - ISR e' persistente, scrivere '1' su ICR azzera il bit corrispondente.
+  * 		 - La callback di interrupt e' invocata quando gpio_int (OR di ISR) passa
+  * 		   da '0' a '1'.
+  * 		 Tutti i pin sono valutati in parallelo sui 32 bit del registro, quindi il
+  * 		 costo di uno stimolo non dipende dal numero di pin che commutano.
+  * 		 Con EMU_attach l'emulatore viene registrato come backend del driver SIM:
+  * 		 BTN_Init, LED_Init e SW_Init vi si collegano senza modifiche.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_EMU_H_
+#define SRC_GPIO_EMU_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_LL.h"
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief passo di uno script di stimolo: i pad selezionati da mask
+  * 		assumono il valore indicato da value
+  */
+typedef struct {
+	uint32_t mask;	/*!< pad da pilotare*/
+	uint32_t value;	/*!< livello dei pad selezionati*/
+} EMU_step_t;
+
+/**
+  * @brief stato dell'emulatore di una periferica APE_GPIO
+  */
+typedef struct {
+	uint32_t data;			/*!< latch di scrittura del registro DATA (slv_reg0)*/
+	uint32_t dir;			/*!< registro DIR*/
+	uint32_t ierr;			/*!< registro IERR*/
+	uint32_t ierf;			/*!< registro IERF*/
+	uint32_t isr;			/*!< registro ISR*/
+	uint32_t pads;			/*!< livelli imposti dall'esterno sui pad*/
+	uint32_t read;			/*!< valore corrente letto dal gpio_array*/
+	uint32_t width_mask;	/*!< maschera dei pin implementati (generic width)*/
+	void (*irq_callback)(void*);	/*!< callback all'asserzione di gpio_int*/
+	void* irq_arg;			/*!< argomento della callback*/
+	uint32_t reads;			/*!< numero di letture effettuate sul bus*/
+	uint32_t writes;		/*!< numero di scritture effettuate sul bus*/
+	uint32_t irqs;			/*!< numero di asserzioni di gpio_int*/
+} EMU_gpio_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+void EMU_Init(EMU_gpio_t*,int);
+#ifdef DRIVER_SIM
+void EMU_attach(EMU_gpio_t*);
+#endif
+void EMU_setIRQCallback(EMU_gpio_t*,void (*)(void*),void*);
+uint32_t EMU_read(void*,uint32_t*,int);
+void EMU_write(void*,uint32_t*,int,uint32_t,uint8_t);
+void EMU_setPads(EMU_gpio_t*,uint32_t,uint32_t);
+void EMU_setPin(EMU_gpio_t*,int,bool);
+void EMU_togglePins(EMU_gpio_t*,uint32_t);
+uint32_t EMU_readPads(EMU_gpio_t*);
+void EMU_runScript(EMU_gpio_t*,const EMU_step_t*,int,int);
+
+#endif /* SRC_GPIO_EMU_H_ */
+/**@}*/
+/**@}*/
@@ -0,0 +1,138 @@
+/**
+  ******************************************************************************
+  * @file    bench_emu.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Benchmark su host dell'emulatore APE_GPIO.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Misura i fronti al secondo elaborati dall'emulatore:
+  * 		 - stimolo diretto di un pin, con rilevazione del fronte e ISR;
+  * 		 - stimolo di tutti i 32 pin insieme (valutazione bit-parallela);
+  * 		 - percorso completo del driver: fronte, interrupt, dispatch della
+  * 		   callback e azzeramento di ISR tramite il backend del driver SIM.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+#include "gpio_emu.h"
+#include "gpio_it.h"
+#include "button.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define BENCH_EDGES		20000000	/*!< fronti per misura, stimolo diretto*/
+#define BENCH_IRQS		2000000		/*!< fronti per misura, percorso del driver*/
+
+/* Variabili -----------------------------------------------------------------*/
+static volatile uint32_t served;	/*!< callback invocate*/
+
+/**
+  * @brief  istante corrente in secondi
+  */
+static double BENCH_now(void){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+  * @brief  callback del pin misurato
+  */
+static void BENCH_callback(void* context,int pin){
+	(void)context;
+	(void)pin;
+	served++;
+}
+
+/**
+  * @brief  handler della linea gpio_int simulata
+  */
+static void BENCH_irq(void* arg){
+	(void)arg;
+	APE_IRQHandler_0();
+}
+
+/**
+  * @brief  fronti su un solo pin, ISR azzerato a ogni fronte
+  */
+static void BENCH_singlePin(void){
+	EMU_gpio_t e;
+	double t;
+	int i;
+
+	EMU_Init(&e,32);
+	e.dir = 0xFFFFFFFF;
+	e.ierr = e.ierf = 0xFFFFFFFF;
+
+	t = BENCH_now();
+	for(i = 0; i < BENCH_EDGES; i++){
+		EMU_togglePins(&e,0x1);
+		e.isr = 0;
+	}
+	t = BENCH_now() - t;
+	printf("emulatore, 1 pin:     %6.1f Mfronti/s (%u interrupt)\n",BENCH_EDGES / t / 1e6,e.irqs);
+}
+
+/**
+  * @brief  fronti su tutti i 32 pin a ogni stimolo
+  */
+static void BENCH_allPins(void){
+	EMU_gpio_t e;
+	double t;
+	int i;
+
+	EMU_Init(&e,32);
+	e.dir = 0xFFFFFFFF;
+	e.ierr = e.ierf = 0xFFFFFFFF;
+
+	t = BENCH_now();
+	for(i = 0; i < BENCH_EDGES; i++){
+		EMU_togglePins(&e,0xFFFFFFFF);
+		e.isr = 0;
+	}
+	t = BENCH_now() - t;
+	printf("emulatore, 32 pin:    %6.1f Mfronti/s\n",32.0 * BENCH_EDGES / t / 1e6);
+}
+
+/**
+  * @brief  fronti serviti dal driver: interrupt, dispatch e azzeramento
+  */
+static void BENCH_driver(void){
+	EMU_gpio_t e;
+	btn_t btn;
+	double t;
+	int i;
+
+	EMU_Init(&e,12);
+	EMU_attach(&e);
+	APE_setBusIRQHandler(&BENCH_irq,NULL);
+	BTN_Init(&btn);
+	btn.enable(&btn);
+	btn.enableInterrupt(&btn,0x1,INT_RIS_FALL);
+	APE_IT_register(&APE_IT_gpio0,BTN0,&BENCH_callback,NULL);
+
+	t = BENCH_now();
+	for(i = 0; i < BENCH_IRQS; i++){
+		EMU_togglePins(&e,BTN0_MASK);
+	}
+	t = BENCH_now() - t;
+	printf("driver, IRQ+dispatch: %6.1f Mfronti/s (%u callback, %u letture, %u scritture)\n",
+			BENCH_IRQS / t / 1e6,served,e.reads,e.writes);
+	APE_IT_unregister(&APE_IT_gpio0,BTN0);
+}
+
+int main(void){
+	BENCH_singlePin();
+	BENCH_allPins();
+	BENCH_driver();
+	return 0;
+}
+/**@}*/
+/**@}*/
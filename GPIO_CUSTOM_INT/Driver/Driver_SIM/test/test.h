@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file    test.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce le macro di verifica dei test su host del
+  * 		 driver SIM.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Ogni test e' un eseguibile: TEST_CHECK conta le verifiche e stampa
+  * 		 quelle fallite, TEST_report stampa il riepilogo e restituisce il
+  * 		 codice di uscita (0 se tutte le verifiche sono passate).
+  ******************************************************************************
+  */
+#ifndef SRC_TEST_H_
+#define SRC_TEST_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+/* Variabili -----------------------------------------------------------------*/
+static int test_checks;		/*!< verifiche eseguite*/
+static int test_failures;	/*!< verifiche fallite*/
+
+/* Macro ---------------------------------------------------------------------*/
+
+/**
+  * @brief verifica una condizione, se falsa stampa file, riga e condizione
+  */
+#define TEST_CHECK(cond)	do{ \
+		test_checks++; \
+		if(!(cond)){ \
+			test_failures++; \
+			printf("%s:%d: verifica fallita: %s\n",__FILE__,__LINE__,#cond); \
+		} \
+	}while(0)
+
+/**
+  * @brief verifica che due valori interi senza segno coincidano, stampandoli
+  * 		in esadecimale se diversi
+  */
+#define TEST_CHECK_EQ(a,b)	do{ \
+		unsigned long long test_a = (unsigned long long)(a); \
+		unsigned long long test_b = (unsigned long long)(b); \
+		test_checks++; \
+		if(test_a != test_b){ \
+			test_failures++; \
+			printf("%s:%d: verifica fallita: %s == %s (0x%llx != 0x%llx)\n",__FILE__,__LINE__,#a,#b,test_a,test_b); \
+		} \
+	}while(0)
+
+/* Funzioni ------------------------------------------------------------------*/
+
+/**
+  * @brief  stampa il riepilogo delle verifiche
+  * @param  name: nome del test
+  * @retval codice di uscita del test
+  */
+static inline int TEST_report(const char* name){
+	printf("%s: %d verifiche, %d fallite\n",name,test_checks,test_failures);
+	return test_failures != 0;
+}
+
+#endif /* SRC_TEST_H_ */
+/**@}*/
+/**@}*/
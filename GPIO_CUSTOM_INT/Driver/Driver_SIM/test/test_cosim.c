@@ -0,0 +1,158 @@
+/**
+  ******************************************************************************
+  * @file    test_cosim.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Test di co-simulazione dei moduli LIB_OBJECTS con l'RTL di
+  * 		 APE_GPIO_TOP simulato da GHDL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Uso: test_cosim <eseguibile di simulazione> [opzioni GHDL]
+  * 		 (make cosim lo elabora con VHDL/tb/build_cosim.sh e lo esegue).
+  * 		 Gli stessi passi di test_emu sono eseguiti sull'RTL: la linea
+  * 		 gpio_int simulata e' consegnata a APE_IRQHandler_0. Al termine sono
+  * 		 riportati i cicli di clock per lettura e scrittura e il costo in
+  * 		 transazioni e cicli di alcune operazioni del driver.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "gpio_cosim.h"
+#include "gpio_it.h"
+#include "button.h"
+#include "led.h"
+#include "switch.h"
+
+/* Variabili -----------------------------------------------------------------*/
+static COSIM_gpio_t sim;			/*!< collegamento con il simulatore*/
+static int pin_count[APE_IT_MAX_PINS];	/*!< callback invocate per pin*/
+
+/**
+  * @brief  handler della linea gpio_int simulata
+  */
+static void irqDispatch(void* arg){
+	(void)arg;
+	APE_IRQHandler_0();
+}
+
+/**
+  * @brief  callback di un pin registrata in APE_IT_gpio0
+  */
+static void pinCallback(void* context,int pin){
+	(void)context;
+	pin_count[pin]++;
+}
+
+/**
+  * @brief  stato dei contatori prima di un'operazione
+  */
+typedef struct {
+	uint32_t reads;
+	uint32_t writes;
+	uint64_t cycles;
+} cost_t;
+
+static cost_t costBegin(void){
+	return (cost_t){ sim.reads, sim.writes, sim.read_cycles + sim.write_cycles };
+}
+
+/**
+  * @brief  stampa transazioni e cicli di bus dall'istante start
+  */
+static void costReport(const char* name,cost_t start){
+	printf("  %-28s %u letture, %u scritture, %llu cicli\n",name,
+			sim.reads - start.reads,sim.writes - start.writes,
+			(unsigned long long)(sim.read_cycles + sim.write_cycles - start.cycles));
+}
+
+int main(int argc,char* argv[]){
+	btn_t btn;
+	led_t led;
+	switch_t sw;
+	cost_t c;
+	int status;
+
+	if(argc < 2){
+		fprintf(stderr,"uso: %s <simulatore> [opzioni]\n",argv[0]);
+		return 2;
+	}
+	if(COSIM_Init(&sim,&argv[1]) < 0){
+		return 2;
+	}
+	COSIM_attach(&sim);
+	APE_setBusIRQHandler(&irqDispatch,NULL);
+
+	BTN_Init(&btn);
+	LED_Init(&led);
+	SW_Init(&sw);
+	btn.enable(&btn);
+	sw.enable(&sw);
+	led.enable(&led);
+
+	/* Led: il pad segue DATA */
+	led.setLeds(&led,0x5);
+	TEST_CHECK_EQ(led.readStatus(&led),0x5);
+	led.toggle(&led,LED1);
+	TEST_CHECK_EQ(led.readStatus(&led),0x7);
+
+	/* Bottoni e switch letti dai pad attraverso DATA */
+	COSIM_setPads(&sim,BTN_ALL_MASK | SW_ALL_MASK,BTN2_MASK | SW1_MASK);
+	TEST_CHECK_EQ(btn.readStatus(&btn),0x4);
+	TEST_CHECK_EQ(sw.readStatus(&sw),0x2);
+
+	/* Interrupt dall'RTL: callback invocate dal dispatch e ISR azzerato */
+	APE_IT_register(&APE_IT_gpio0,BTN1,&pinCallback,NULL);
+	APE_IT_register(&APE_IT_gpio0,SW3,&pinCallback,NULL);
+	btn.enableInterrupt(&btn,0x2,INT_RISING);
+	sw.enableInterrupt(&sw,0x8,INT_FALLING);
+
+	COSIM_setPin(&sim,BTN1,true);
+	TEST_CHECK_EQ(sim.irqs,1);
+	TEST_CHECK_EQ(pin_count[BTN1],1);
+	TEST_CHECK_EQ(sim.irq,0);
+
+	COSIM_setPin(&sim,SW3,true);
+	COSIM_setPin(&sim,SW3,false);
+	TEST_CHECK_EQ(sim.irqs,2);
+	TEST_CHECK_EQ(pin_count[SW3],1);
+
+	/* Fronte non abilitato e interrupt disabilitata */
+	COSIM_setPin(&sim,BTN1,false);
+	btn.disableInterrupt(&btn,0x2,INT_RISING);
+	COSIM_setPin(&sim,BTN1,true);
+	TEST_CHECK_EQ(sim.irqs,2);
+	TEST_CHECK_EQ(btn.readISR(&btn),0x0);
+
+	/* Costo delle operazioni sul bus simulato */
+	printf("test_cosim: %.1f cicli per lettura, %.1f per scrittura\n",
+			(double)sim.read_cycles / sim.reads,(double)sim.write_cycles / sim.writes);
+	c = costBegin();
+	led.toggle(&led,LED0);
+	costReport("LED toggle",c);
+	c = costBegin();
+	led.setLeds(&led,0xA);
+	costReport("LED setLeds",c);
+	c = costBegin();
+	btn.enableInterrupt(&btn,0x1,INT_RIS_FALL);
+	costReport("BTN enableInterrupt",c);
+	APE_IT_register(&APE_IT_gpio0,BTN0,&pinCallback,NULL);
+	c = costBegin();
+	COSIM_setPin(&sim,BTN0,true);
+	costReport("servizio interrupt BTN0",c);
+	TEST_CHECK_EQ(pin_count[BTN0],1);
+
+	APE_IT_unregister(&APE_IT_gpio0,BTN0);
+	APE_IT_unregister(&APE_IT_gpio0,BTN1);
+	APE_IT_unregister(&APE_IT_gpio0,SW3);
+
+	status = COSIM_close(&sim);
+	TEST_CHECK_EQ(status,0);
+	return TEST_report("test_cosim");
+}
+/**@}*/
+/**@}*/
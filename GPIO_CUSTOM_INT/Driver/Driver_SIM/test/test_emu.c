@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file    test_emu.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Test su host dell'emulatore APE_GPIO e del collegamento dei
+  * 		 moduli LIB_OBJECTS al backend del driver SIM.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "gpio_emu.h"
+#include "gpio_it.h"
+#include "button.h"
+#include "led.h"
+#include "switch.h"
+
+/* Variabili -----------------------------------------------------------------*/
+static int irq_count;		/*!< asserzioni di gpio_int ricevute*/
+static int pin_count[APE_IT_MAX_PINS];	/*!< callback invocate per pin*/
+
+/**
+  * @brief  callback di interrupt dell'emulatore usato senza driver
+  */
+static void irqCount(void* arg){
+	(void)arg;
+	irq_count++;
+}
+
+/**
+  * @brief  handler della linea gpio_int simulata, come la IRQ Handler
+  * 		registrata nel GIC nel driver BARE
+  */
+static void irqDispatch(void* arg){
+	(void)arg;
+	irq_count++;
+	APE_IRQHandler_0();
+}
+
+/**
+  * @brief  callback di un pin registrata in APE_IT_gpio0
+  */
+static void pinCallback(void* context,int pin){
+	(void)context;
+	pin_count[pin]++;
+}
+
+/**
+  * @brief  semantica dei registri, con accessi diretti all'emulatore
+  */
+static void testRegisters(void){
+	EMU_gpio_t e;
+
+	EMU_Init(&e,12);
+	EMU_setIRQCallback(&e,&irqCount,NULL);
+	irq_count = 0;
+
+	/* Reset: tutti i registri azzerati, tutti i pin in uscita */
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_DATA_REG),0);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_DIR_REG),0);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0);
+
+	/* DIR: i pin in uscita riportano DATA, quelli in ingresso i pad */
+	EMU_write(&e,NULL,APE_DIR_REG,0x00F,0xF);
+	EMU_write(&e,NULL,APE_DATA_REG,0xFF5,0xF);
+	EMU_setPads(&e,0xFFF,0x00A);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_DATA_REG),0xFFA);
+	TEST_CHECK_EQ(EMU_readPads(&e),0xFFA);
+
+	/* Pin oltre width non implementati */
+	EMU_write(&e,NULL,APE_DATA_REG,0xFFFFFFFF,0xF);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_DATA_REG),0xFFA);
+
+	/* Byte lane: solo il byte 1 di IERR e' scritto */
+	EMU_write(&e,NULL,APE_IERR_REG,0x11223344,0xF);
+	EMU_write(&e,NULL,APE_IERR_REG,0xAABBCCDD,0x2);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_IERR_REG),0x1122CC44);
+
+	/* Fronti: salita su pin 0, discesa su pin 1, entrambi su pin 2
+	   (pad iniziali: pin 1 e 3 alti) */
+	EMU_write(&e,NULL,APE_IERR_REG,0x5,0xF);
+	EMU_write(&e,NULL,APE_IERF_REG,0x6,0xF);
+	EMU_write(&e,NULL,APE_ICRISR_REG,0xFFF,0xF);
+	EMU_setPads(&e,0xF,0x0);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x2);
+	TEST_CHECK_EQ(irq_count,1);
+	EMU_setPads(&e,0xF,0xF);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x7);
+	TEST_CHECK_EQ(irq_count,1);
+
+	/* Fronti non abilitati: pin 3 non ha IERR/IERF, pin 1 non ha IERR */
+	EMU_write(&e,NULL,APE_ICRISR_REG,0x7,0xF);
+	EMU_setPin(&e,3,false);
+	EMU_setPin(&e,3,true);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x0);
+	EMU_setPin(&e,1,true);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x0);
+
+	/* ISR persistente e azzeramento selettivo, una asserzione di gpio_int
+	   per ogni passaggio da 0 a diverso da 0 */
+	EMU_setPin(&e,0,false);
+	EMU_setPin(&e,0,true);
+	EMU_setPin(&e,2,false);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x5);
+	TEST_CHECK_EQ(irq_count,2);
+	EMU_write(&e,NULL,APE_ICRISR_REG,0x1,0xF);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x4);
+	EMU_setPin(&e,0,false);
+	EMU_setPin(&e,0,true);
+	TEST_CHECK_EQ(irq_count,2);
+	EMU_write(&e,NULL,APE_ICRISR_REG,0x5,0xF);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x0);
+
+	/* DIR gating: i fronti dei pin in uscita non impostano ISR */
+	EMU_write(&e,NULL,APE_IERR_REG,0xF00,0xF);
+	EMU_write(&e,NULL,APE_IERF_REG,0xF00,0xF);
+	EMU_write(&e,NULL,APE_DATA_REG,0x000,0xF);
+	EMU_write(&e,NULL,APE_DATA_REG,0xF00,0xF);
+	TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x0);
+
+	/* Uno script di stimolo produce i fronti nell'ordine dei passi */
+	{
+		const EMU_step_t script[] = { { 0x1, 0x0 }, { 0x1, 0x1 } };
+
+		EMU_write(&e,NULL,APE_IERR_REG,0x1,0xF);
+		EMU_write(&e,NULL,APE_IERF_REG,0x0,0xF);
+		irq_count = 0;
+		EMU_runScript(&e,script,2,10);
+		TEST_CHECK_EQ(EMU_read(&e,NULL,APE_ICRISR_REG),0x1);
+		TEST_CHECK_EQ(irq_count,1);
+	}
+}
+
+/**
+  * @brief  BTN_Init, LED_Init e SW_Init collegati all'emulatore tramite
+  * 		il backend del driver SIM, con consegna delle interrupt alla
+  * 		tabella di dispatch
+  */
+static void testObjects(void){
+	EMU_gpio_t e;
+	btn_t btn;
+	led_t led;
+	switch_t sw;
+
+	EMU_Init(&e,12);
+	EMU_attach(&e);
+	APE_setBusIRQHandler(&irqDispatch,NULL);
+	irq_count = 0;
+
+	BTN_Init(&btn);
+	LED_Init(&led);
+	SW_Init(&sw);
+	btn.enable(&btn);
+	sw.enable(&sw);
+	led.enable(&led);
+	TEST_CHECK_EQ(e.dir,BTN_ALL_MASK | SW_ALL_MASK);
+
+	/* Led: i pad seguono DATA */
+	led.setLeds(&led,0x5);
+	TEST_CHECK_EQ(EMU_readPads(&e) & LED_ALL_MASK,0x5u << LED_NIBBLE_OFFSET);
+	led.toggle(&led,LED1);
+	TEST_CHECK_EQ(led.readStatus(&led),0x7);
+
+	/* Bottoni e switch: i pad sono letti attraverso DATA */
+	EMU_setPads(&e,BTN_ALL_MASK | SW_ALL_MASK,BTN2_MASK | SW1_MASK);
+	TEST_CHECK_EQ(btn.readStatus(&btn),0x4);
+	TEST_CHECK_EQ(sw.readStatus(&sw),0x2);
+	TEST_CHECK_EQ(sw.readSwitch(&sw,SW1),1);
+
+	/* Interrupt: la callback del pin e' invocata dal dispatch e ISR azzerato */
+	APE_IT_register(&APE_IT_gpio0,BTN1,&pinCallback,NULL);
+	APE_IT_register(&APE_IT_gpio0,SW3,&pinCallback,NULL);
+	btn.enableInterrupt(&btn,0x2,INT_RISING);
+	sw.enableInterrupt(&sw,0x8,INT_FALLING);
+	TEST_CHECK_EQ(e.ierr,BTN1_MASK);
+	TEST_CHECK_EQ(e.ierf,SW3_MASK);
+
+	EMU_setPin(&e,BTN1,true);
+	TEST_CHECK_EQ(irq_count,1);
+	TEST_CHECK_EQ(pin_count[BTN1],1);
+	TEST_CHECK_EQ(e.isr,0);
+
+	EMU_setPin(&e,SW3,true);
+	EMU_setPin(&e,SW3,false);
+	TEST_CHECK_EQ(irq_count,2);
+	TEST_CHECK_EQ(pin_count[SW3],1);
+
+	/* Fronti non abilitati e pin disabilitati */
+	EMU_setPin(&e,BTN1,false);
+	btn.disableInterrupt(&btn,0x2,INT_RISING);
+	EMU_setPin(&e,BTN1,true);
+	TEST_CHECK_EQ(irq_count,2);
+	TEST_CHECK_EQ(pin_count[BTN1],1);
+
+	APE_IT_unregister(&APE_IT_gpio0,BTN1);
+	APE_IT_unregister(&APE_IT_gpio0,SW3);
+}
+
+int main(void){
+	testRegisters();
+	testObjects();
+	return TEST_report("test_emu");
+}
+/**@}*/
+/**@}*/
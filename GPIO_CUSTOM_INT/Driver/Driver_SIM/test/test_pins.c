@@ -0,0 +1,301 @@
+/**
+  ******************************************************************************
+  * @file    test_pins.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Test su host delle transazioni di bus generate dagli accessori
+  * 		 inline, dai moduli LIB_OBJECTS e dai banchi di GPIO_PINS.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Il backend di questo test inoltra ogni accesso all'emulatore e lo
+  * 		 registra in una traccia (tipo, registro, byte lane): le verifiche
+  * 		 confrontano la traccia con il numero di accessi e le WSTRB attese.
+  * 		 Compilato con TEST_PINSET_REJECT=1 (scrittura di un pin in ingresso)
+  * 		 o 2 (set e clear sovrapposti) il test non deve compilare: make check
+  * 		 verifica anche questo.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "gpio_emu.h"
+#include "gpio_LL_inline.h"
+#include "gpio_pins.h"
+#include "button.h"
+#include "led.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define TRACE_MAX	16	/*!< accessi registrati per operazione*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief accesso al bus registrato nella traccia
+  */
+typedef struct {
+	char op;		/*!< 'R' lettura, 'W' scrittura*/
+	int offset;		/*!< registro acceduto*/
+	uint8_t strb;	/*!< byte lane attive (0xF per le letture)*/
+	uint32_t value;	/*!< valore letto o scritto*/
+} trace_t;
+
+/* Variabili -----------------------------------------------------------------*/
+static EMU_gpio_t emu;				/*!< periferica emulata*/
+static trace_t trace[TRACE_MAX];	/*!< accessi dell'operazione corrente*/
+static int trace_len;				/*!< accessi registrati, anche oltre TRACE_MAX*/
+
+/**
+  * @brief  lettura del backend: registra l'accesso e lo inoltra all'emulatore
+  */
+static uint32_t traceRead(void* ctx,uint32_t* addr,int offset){
+	uint32_t value = EMU_read(ctx,addr,offset);
+
+	if(trace_len < TRACE_MAX){
+		trace[trace_len] = (trace_t){ 'R', offset, 0xF, value };
+	}
+	trace_len++;
+	return value;
+}
+
+/**
+  * @brief  scrittura del backend: registra l'accesso e lo inoltra all'emulatore
+  */
+static void traceWrite(void* ctx,uint32_t* addr,int offset,uint32_t value,uint8_t strb){
+	if(trace_len < TRACE_MAX){
+		trace[trace_len] = (trace_t){ 'W', offset, strb, value };
+	}
+	trace_len++;
+	EMU_write(ctx,addr,offset,value,strb);
+}
+
+/**
+  * @brief  azzera la traccia prima dell'operazione da verificare
+  */
+static void traceBegin(void){
+	trace_len = 0;
+}
+
+/**
+  * @brief  verifica l'accesso i-esimo della traccia
+  */
+#define TRACE_CHECK(i,o,reg,lanes)	do{ \
+		TEST_CHECK((i) < trace_len); \
+		TEST_CHECK_EQ(trace[i].op,o); \
+		TEST_CHECK_EQ(trace[i].offset,reg); \
+		TEST_CHECK_EQ(trace[i].strb,lanes); \
+	}while(0)
+
+/**
+  * @brief  accessori inline: una transazione per accesso, read-modify-write
+  * 		in una lettura e una scrittura, store parziali sulle sole byte lane
+  * 		selezionate
+  */
+static void testAccessors(void){
+	uint32_t* base = (uint32_t*)GPIO_0_BASE_ADDRESS;
+	uint32_t value;
+	int part;
+
+	traceBegin();
+	value = APE_READ32(base,APE_DIR_REG);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'R',APE_DIR_REG,0xF);
+	TEST_CHECK_EQ(value,emu.dir);
+
+	traceBegin();
+	APE_WRITE32(base,APE_IERR_REG,0x12345678);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'W',APE_IERR_REG,0xF);
+
+	traceBegin();
+	APE_SET32(base,APE_IERF_REG,0x10);
+	APE_CLEAR32(base,APE_IERF_REG,0x10);
+	APE_TOGGLE32(base,APE_IERF_REG,0x3);
+	TEST_CHECK_EQ(trace_len,6);
+	TRACE_CHECK(0,'R',APE_IERF_REG,0xF);
+	TRACE_CHECK(1,'W',APE_IERF_REG,0xF);
+	TRACE_CHECK(4,'R',APE_IERF_REG,0xF);
+	TRACE_CHECK(5,'W',APE_IERF_REG,0xF);
+	TEST_CHECK_EQ(emu.ierf,0x3);
+
+	/* Store a 8 e 16 bit: una WSTRB per byte, due per half-word */
+	APE_WRITE32(base,APE_IERR_REG,0x0);
+	for(part = LL; part <= HH; part++){
+		traceBegin();
+		APE_WRITE8(base,APE_IERR_REG,0xA5,part);
+		TEST_CHECK_EQ(trace_len,1);
+		TRACE_CHECK(0,'W',APE_IERR_REG,0x1u << part);
+	}
+	TEST_CHECK_EQ(emu.ierr,0xA5A5A5A5);
+	for(part = L; part <= H; part++){
+		traceBegin();
+		APE_WRITE16(base,APE_IERR_REG,0x5AA5,part);
+		TEST_CHECK_EQ(trace_len,1);
+		TRACE_CHECK(0,'W',APE_IERR_REG,0x3u << (2 * part));
+	}
+	TEST_CHECK_EQ(emu.ierr,0x5AA55AA5);
+	APE_WRITE32(base,APE_IERR_REG,0x0);
+	APE_WRITE32(base,APE_IERF_REG,0x0);
+}
+
+/**
+  * @brief  LIB_OBJECTS: costo in transazioni delle operazioni sui pin
+  */
+static void testObjects(void){
+	btn_t btn;
+	led_t led;
+
+	BTN_Init(&btn);
+	LED_Init(&led);
+	btn.enable(&btn);
+	led.enable(&led);
+
+	traceBegin();
+	led.toggle(&led,LED2);
+	TEST_CHECK_EQ(trace_len,2);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'W',APE_DATA_REG,0xF);
+	TEST_CHECK_EQ(emu.data & LED_ALL_MASK,LED2_MASK);
+
+	/* setLeds: una sola store a 8 bit sul byte che contiene il nibble */
+	traceBegin();
+	led.setLeds(&led,0x9);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'W',APE_DATA_REG,0x1u << (LED_NIBBLE_OFFSET / 8));
+	TEST_CHECK_EQ(led.readStatus(&led),0x9);
+
+	traceBegin();
+	TEST_CHECK_EQ(btn.readStatus(&btn),0x0);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+}
+
+/**
+  * @brief  banchi a dispatch statico: stesse transazioni degli oggetti,
+  * 		clearISR con la sola scrittura su ICR
+  */
+static void testBanks(void){
+	LED_BANK_setLeds(0x0);
+
+	traceBegin();
+	LED_BANK_setOn(LED1);
+	LED_BANK_setOff(LED1);
+	TEST_CHECK_EQ(trace_len,4);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'W',APE_DATA_REG,0xF);
+	TRACE_CHECK(2,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(3,'W',APE_DATA_REG,0xF);
+
+	traceBegin();
+	LED_BANK_toggle(LED0);
+	TEST_CHECK_EQ(trace_len,2);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'W',APE_DATA_REG,0xF);
+
+	traceBegin();
+	LED_BANK_setLeds(0x6);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'W',APE_DATA_REG,0x1u << (LED_NIBBLE_OFFSET / 8));
+
+	traceBegin();
+	TEST_CHECK_EQ(LED_BANK_readStatus(),0x6);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+
+	/* Banchi in ingresso: letture singole di DATA e ISR */
+	emu.dir |= SW_ALL_MASK;
+	EMU_setPads(&emu,BTN_ALL_MASK | SW_ALL_MASK,BTN3_MASK | SW0_MASK);
+	traceBegin();
+	TEST_CHECK_EQ(BTN_BANK_readStatus(),0x8);
+	TEST_CHECK_EQ(BTN_BANK_readPin(BTN3),1);
+	TEST_CHECK_EQ(SW_BANK_readStatus(),0x1);
+	TEST_CHECK_EQ(trace_len,3);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(2,'R',APE_DATA_REG,0xF);
+
+	/* readISR e' una lettura; clearISR una sola scrittura su ICR, senza
+	   lettura di ISR, che azzera i soli bit del banco indicati */
+	emu.ierr = BTN_ALL_MASK;
+	EMU_setPads(&emu,BTN_ALL_MASK,BTN0_MASK | BTN1_MASK | BTN3_MASK);
+	TEST_CHECK_EQ(emu.isr,BTN0_MASK | BTN1_MASK);
+	traceBegin();
+	TEST_CHECK_EQ(BTN_BANK_readISR(),0x3);
+	BTN_BANK_clearISR(0x1);
+	TEST_CHECK_EQ(trace_len,2);
+	TRACE_CHECK(0,'R',APE_ICRISR_REG,0xF);
+	TRACE_CHECK(1,'W',APE_ICRISR_REG,0xF);
+	TEST_CHECK_EQ(trace[1].value,BTN0_MASK);
+	TEST_CHECK_EQ(emu.isr,BTN1_MASK);
+	BTN_BANK_clearISR(0xF);
+	emu.ierr = 0;
+}
+
+/**
+  * @brief  insiemi di pin: una lettura e al piu' una scrittura per
+  * 		qualunque combinazione di pin
+  */
+static void testPinset(void){
+	uint32_t btn;
+
+	LED_BANK_setLeds(0x0);
+
+	traceBegin();
+	APE_PINSET_WRITE(GPIO_0_BASE_ADDRESS,LED0_MASK | LED2_MASK,LED1_MASK | LED3_MASK);
+	TEST_CHECK_EQ(trace_len,2);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'W',APE_DATA_REG,0xF);
+	TEST_CHECK_EQ(LED_BANK_readStatus(),0x5);
+
+	/* Nessuna variazione: la scrittura e' omessa */
+	traceBegin();
+	APE_PINSET_WRITE(GPIO_0_BASE_ADDRESS,LED0_MASK,LED1_MASK);
+	TEST_CHECK_EQ(trace_len,1);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+
+	traceBegin();
+	APE_PINSET_TOGGLE(GPIO_0_BASE_ADDRESS,LED_ALL_MASK);
+	TEST_CHECK_EQ(trace_len,2);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'W',APE_DATA_REG,0xF);
+	TEST_CHECK_EQ(LED_BANK_readStatus(),0xA);
+
+	/* Lettura e aggiornamento: gli ingressi arrivano dalla stessa lettura */
+	EMU_setPads(&emu,BTN_ALL_MASK | SW_ALL_MASK,BTN1_MASK | SW2_MASK);
+	traceBegin();
+	TEST_CHECK_EQ(APE_PINSET_READ(GPIO_0_BASE_ADDRESS,BTN1_MASK | SW2_MASK | LED1_MASK),
+			BTN1_MASK | SW2_MASK | LED1_MASK);
+	TEST_CHECK_EQ(trace_len,1);
+
+	traceBegin();
+	btn = APE_PINSET_UPDATE(GPIO_0_BASE_ADDRESS,LED0_MASK | LED2_MASK,LED3_MASK,BTN_ALL_MASK);
+	TEST_CHECK_EQ(btn,BTN1_MASK);
+	TEST_CHECK_EQ(trace_len,2);
+	TRACE_CHECK(0,'R',APE_DATA_REG,0xF);
+	TRACE_CHECK(1,'W',APE_DATA_REG,0xF);
+	TEST_CHECK_EQ(LED_BANK_readStatus(),0x7);
+
+#if TEST_PINSET_REJECT == 1
+	APE_PINSET_WRITE(GPIO_0_BASE_ADDRESS,LED0_MASK | BTN0_MASK,0);
+#elif TEST_PINSET_REJECT == 2
+	APE_PINSET_WRITE(GPIO_0_BASE_ADDRESS,LED0_MASK,LED0_MASK);
+#endif
+}
+
+int main(void){
+	const APE_bus_t bus = { &traceRead, &traceWrite, &emu };
+
+	EMU_Init(&emu,12);
+	APE_setBus(&bus);
+
+	testAccessors();
+	testObjects();
+	testBanks();
+	testPinset();
+	return TEST_report("test_pins");
+}
+/**@}*/
+/**@}*/
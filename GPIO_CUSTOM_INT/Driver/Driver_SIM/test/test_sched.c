@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    test_sched.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Test su host della timer wheel dello scheduler BARE_METAL.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Su host la WFI e il mascheramento delle IRQ sono vuoti: ogni
+  * 		 tick e' contato con APE_SCHED_tick e servito da APE_SCHED_run.
+  * 		 Le verifiche riguardano i timer fermati o riavviati dalle
+  * 		 callback mentre sono scaduti e non ancora serviti.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "test.h"
+#include "scheduler.h"
+
+/* Variabili -----------------------------------------------------------------*/
+static sched_timer_t timer_a;	/*!< timer che agisce su timer_b*/
+static sched_timer_t timer_b;	/*!< timer periodico*/
+static int count_a;				/*!< scadenze di timer_a*/
+static int count_b;				/*!< scadenze di timer_b*/
+static uint32_t last_b;			/*!< tick dell'ultima scadenza di timer_b*/
+static uint32_t now;			/*!< tick contati dal test*/
+
+/**
+  * @brief  conta i tick indicati e li fa servire allo scheduler
+  */
+static void advance(uint32_t ticks){
+	while(ticks-- > 0){
+		now++;
+		APE_SCHED_tick();
+		APE_SCHED_run();
+	}
+}
+
+static void callbackB(void* context){
+	(void)context;
+	count_b++;
+	last_b = now;
+}
+
+static void restartB(void* context){
+	(void)context;
+	count_a++;
+	APE_SCHED_startTimer(&timer_b,&callbackB,NULL,5,5);
+}
+
+static void stopB(void* context){
+	(void)context;
+	count_a++;
+	APE_SCHED_stopTimer(&timer_b);
+}
+
+static void stopSelf(void* context){
+	count_b++;
+	if(count_b == 2){
+		APE_SCHED_stopTimer((sched_timer_t*)context);
+	}
+}
+
+static void restartSelf(void* context){
+	count_b++;
+	last_b = now;
+	APE_SCHED_startTimer((sched_timer_t*)context,&restartSelf,context,3,5);
+}
+
+/**
+  * @brief  azzera scheduler, timer e contatori
+  */
+static void reset(void){
+	APE_SCHED_Init();
+	memset(&timer_a,0,sizeof(timer_a));
+	memset(&timer_b,0,sizeof(timer_b));
+	count_a = count_b = 0;
+	last_b = now = 0;
+}
+
+int main(void){
+	int i;
+
+	/* A riavvia B scaduto nello stesso tick: B scade ogni 5 tick dal riavvio */
+	for(i = 0; i < 2; i++){
+		reset();
+		if(i == 0){
+			APE_SCHED_startTimer(&timer_a,&restartB,NULL,5,0);
+			APE_SCHED_startTimer(&timer_b,&callbackB,NULL,5,5);
+		}else{
+			APE_SCHED_startTimer(&timer_b,&callbackB,NULL,5,5);
+			APE_SCHED_startTimer(&timer_a,&restartB,NULL,5,0);
+		}
+		advance(5);
+		TEST_CHECK_EQ(count_a,1);
+		count_b = 0;
+		advance(20);
+		TEST_CHECK_EQ(count_b,4);
+		TEST_CHECK_EQ(last_b,25);
+	}
+
+	/* A ferma B scaduto nello stesso tick: B non e' piu' invocato */
+	for(i = 0; i < 2; i++){
+		reset();
+		if(i == 0){
+			APE_SCHED_startTimer(&timer_a,&stopB,NULL,5,0);
+			APE_SCHED_startTimer(&timer_b,&callbackB,NULL,5,5);
+		}else{
+			APE_SCHED_startTimer(&timer_b,&callbackB,NULL,5,5);
+			APE_SCHED_startTimer(&timer_a,&stopB,NULL,5,0);
+		}
+		advance(25);
+		TEST_CHECK_EQ(count_a,1);
+		TEST_CHECK_EQ(count_b,(i == 0) ? 0 : 1);
+	}
+
+	/* Timer periodico fermato dalla propria callback: non reinserito */
+	reset();
+	APE_SCHED_startTimer(&timer_b,&stopSelf,&timer_b,2,2);
+	advance(20);
+	TEST_CHECK_EQ(count_b,2);
+
+	/* Timer periodico riavviato dalla propria callback: vale il nuovo ritardo */
+	reset();
+	APE_SCHED_startTimer(&timer_b,&restartSelf,&timer_b,3,5);
+	advance(20);
+	TEST_CHECK_EQ(count_b,6);
+	TEST_CHECK_EQ(last_b,18);
+
+	/* Ritardi oltre un giro della wheel */
+	reset();
+	APE_SCHED_startTimer(&timer_b,&callbackB,NULL,APE_SCHED_WHEEL_SLOTS * 2 + 3,0);
+	advance(APE_SCHED_WHEEL_SLOTS * 2 + 2);
+	TEST_CHECK_EQ(count_b,0);
+	advance(APE_SCHED_WHEEL_SLOTS * 2);
+	TEST_CHECK_EQ(count_b,1);
+	TEST_CHECK_EQ(last_b,APE_SCHED_WHEEL_SLOTS * 2 + 3);
+
+	return TEST_report("test_sched");
+}
+/**@}*/
+/**@}*/
@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file    test_shadow.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Test su host della copia dei registri di configurazione
+  * 		 (GPIO_SHADOW).
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   L'emulatore ignora l'indirizzo base: tutte le copie sono lette
+  * 		 dagli stessi registri, le verifiche riguardano l'assegnazione
+  * 		 delle copie agli indirizzi.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "gpio_emu.h"
+#include "gpio_shadow.h"
+
+int main(void){
+	EMU_gpio_t e;
+	uint32_t* base0 = NULL;				/* GPIO_0_BASE_ADDRESS nei driver SIM e UIO */
+	uint32_t* base1 = (uint32_t*)0x1000;
+	gpio_shadow_t* s0;
+	gpio_shadow_t* s1;
+	int i;
+
+	EMU_Init(&e,32);
+	EMU_attach(&e);
+
+	/* L'indirizzo NULL e' una periferica: la copia e' letta al primo uso */
+	e.ierr = 0x100;
+	APE_SHADOW_update(base0,APE_IERR_REG,0x200,0);
+	TEST_CHECK_EQ(e.ierr,0x300);
+
+	/* Un secondo indirizzo ha una copia distinta */
+	s0 = APE_SHADOW_get(base0);
+	s1 = APE_SHADOW_get(base1);
+	TEST_CHECK(s0 != NULL && s1 != NULL && s0 != s1);
+	TEST_CHECK(APE_SHADOW_get(base0) == s0);
+
+	/* Dopo invalidate la copia e' riletta: nessun valore ereditato */
+	e.ierr = 0x001;
+	APE_SHADOW_invalidate(base0);
+	APE_SHADOW_update(base0,APE_IERR_REG,0x002,0);
+	TEST_CHECK_EQ(e.ierr,0x003);
+	TEST_CHECK(APE_SHADOW_get(base1) == s1);
+
+	/* La copia liberata e' riassegnata senza duplicare quella di base1 */
+	APE_SHADOW_invalidate(base0);
+	APE_SHADOW_invalidate(base0);
+	s0 = APE_SHADOW_get(base0);
+	TEST_CHECK(s0 != NULL && s0 != s1);
+	TEST_CHECK(APE_SHADOW_get(base1) == s1);
+
+	/* Copie esaurite: l'aggiornamento ricade su lettura e scrittura */
+	for(i = 2; i < APE_SHADOW_MAX; i++){
+		TEST_CHECK(APE_SHADOW_get((uint32_t*)(uintptr_t)(0x1000 * i)) != NULL);
+	}
+	TEST_CHECK(APE_SHADOW_get((uint32_t*)0x8000) == NULL);
+	e.ierf = 0x10;
+	e.reads = e.writes = 0;
+	APE_SHADOW_update((uint32_t*)0x8000,APE_IERF_REG,0x1,0x10);
+	TEST_CHECK_EQ(e.ierf,0x1);
+	TEST_CHECK_EQ(e.reads,1);
+	TEST_CHECK_EQ(e.writes,1);
+
+	return TEST_report("test_shadow");
+}
+/**@}*/
+/**@}*/
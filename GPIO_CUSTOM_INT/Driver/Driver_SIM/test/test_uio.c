@@ -0,0 +1,291 @@
+/**
+  ******************************************************************************
+  * @file    test_uio.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Test su host del runtime UIO (uio_runtime.h) con l'emulatore al
+  * 		 posto del device file.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup SIM
+  * @{
+  * @brief   Il device file e' una FIFO: il lato kernel e' simulato dalla
+  * 		 callback di interrupt dell'emulatore, che scrive il contatore
+  * 		 nella FIFO come farebbe uio_pdrv_genirq. Il collegamento con
+  * 		 -Wl,--wrap=mmap,--wrap=munmap,--wrap=write (vedi Makefile)
+  * 		 sostituisce la mappatura dei registri, che passano dal bus
+  * 		 emulato, e la write() di riarmo della linea.
+  * 		 Il modello del kernel segue la disabilitazione pigra di Linux:
+  * 		 un'interrupt arrivata con la linea disabilitata resta pendente
+  * 		 e viene consegnata al riarmo.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "test.h"
+#include "gpio_emu.h"
+#include "uio_runtime.h"
+#include "switch.h"
+
+/* Variabili -----------------------------------------------------------------*/
+static EMU_gpio_t emu;				/*!< periferica emulata*/
+static uint32_t regs[UIO_RT_MAP_SIZE / sizeof(uint32_t)];	/*!< mappatura fittizia, i registri passano dal bus*/
+static int dev_fd = -1;				/*!< lato utente del device file, noto alla mappatura*/
+static int kernel_fd = -1;			/*!< lato kernel del device file*/
+static int kernel_enabled;			/*!< linea abilitata nel kernel*/
+static int kernel_pending;			/*!< interrupt arrivata con la linea disabilitata*/
+static uint32_t kernel_count;		/*!< interrupt gestite dal kernel*/
+static int callbacks;				/*!< callback invocate*/
+static int chain;					/*!< fronti ancora da generare dalle callback*/
+static long busy_ns;				/*!< durata dell'attesa attiva nelle callback*/
+
+ssize_t __real_write(int,const void*,size_t);
+void* __real_mmap(void*,size_t,int,int,int,off_t);
+int __real_munmap(void*,size_t);
+
+/**
+  * @brief  gestione dell'interrupt nel kernel: conta, disabilita la linea e
+  * 		risveglia il lettore del device file
+  */
+static void kernelIRQ(void){
+	kernel_count++;
+	kernel_enabled = 0;
+	__real_write(kernel_fd,&kernel_count,sizeof(kernel_count));
+}
+
+/**
+  * @brief  asserzione di gpio_int nell'emulatore
+  */
+static void emuIRQ(void* arg){
+	(void)arg;
+	if(kernel_enabled){
+		kernelIRQ();
+	}else{
+		kernel_pending = 1;
+	}
+}
+
+/**
+  * @brief  mmap() del device file: restituisce la mappatura fittizia
+  */
+void* __wrap_mmap(void* addr,size_t len,int prot,int flags,int fd,off_t off){
+	struct stat st;
+
+	if(fd >= 0 && fstat(fd,&st) == 0 && S_ISFIFO(st.st_mode)){
+		dev_fd = fd;
+		return regs;
+	}
+	return __real_mmap(addr,len,prot,flags,fd,off);
+}
+
+int __wrap_munmap(void* addr,size_t len){
+	if(addr == regs){
+		return 0;
+	}
+	return __real_munmap(addr,len);
+}
+
+/**
+  * @brief  write() sul device file: riabilita la linea e consegna
+  * 		l'interrupt pendente
+  */
+ssize_t __wrap_write(int fd,const void* buf,size_t len){
+	if(fd < 0 || fd != dev_fd){
+		return __real_write(fd,buf,len);
+	}
+	kernel_enabled = 1;
+	if(kernel_pending){
+		kernel_pending = 0;
+		kernelIRQ();
+	}
+	return len;
+}
+
+/**
+  * @brief  callback dei pin: attende busy_ns, conta e, finche' chain e'
+  * 		positivo, genera un nuovo fronte su SW1 durante il dispatch
+  */
+static void pinCallback(void* context,int pin){
+	struct timespec start;
+	struct timespec now;
+
+	(void)context;
+	(void)pin;
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	do{
+		clock_gettime(CLOCK_MONOTONIC,&now);
+	}while((now.tv_sec - start.tv_sec) * 1000000000L + (now.tv_nsec - start.tv_nsec) < busy_ns);
+
+	callbacks++;
+	if(chain > 0){
+		chain--;
+		EMU_togglePins(&emu,SW1_MASK);
+	}
+}
+
+/**
+  * @brief  esegue UIO_RT_report raccogliendo in buf le righe stampate
+  */
+static void report(uio_rt_t* rt,char* buf,size_t len){
+	FILE* f = tmpfile();
+	size_t n = 0;
+	int saved;
+
+	fflush(stdout);
+	saved = dup(STDOUT_FILENO);
+	if(f != NULL){
+		dup2(fileno(f),STDOUT_FILENO);
+	}
+	UIO_RT_report(rt,0);
+	fflush(stdout);
+	dup2(saved,STDOUT_FILENO);
+	close(saved);
+	if(f != NULL){
+		rewind(f);
+		n = fread(buf,1,len - 1,f);
+		fclose(f);
+	}
+	buf[n] = '\0';
+}
+
+int main(void){
+	char dir[] = "/tmp/test_uio.XXXXXX";
+	char path[64];
+	char text[1024];
+	uio_rt_t rt;
+	switch_t sw;
+	uint64_t polled;
+	int dev;
+	int pin;
+
+	/* Device file: FIFO aperta dal test come kernel e dal runtime */
+	if(mkdtemp(dir) == NULL){
+		perror("mkdtemp");
+		return 2;
+	}
+	snprintf(path,sizeof(path),"%s/uio0",dir);
+	if(mkfifo(path,0600) < 0 || (kernel_fd = open(path,O_RDWR | O_NONBLOCK)) < 0){
+		perror(path);
+		return 2;
+	}
+
+	EMU_Init(&emu,12);
+	EMU_attach(&emu);
+	EMU_setIRQCallback(&emu,&emuIRQ,NULL);
+
+	/* UIO_RT_open mappa i registri e abilita la linea */
+	TEST_CHECK_EQ(UIO_RT_Init(&rt),0);
+	dev = UIO_RT_open(&rt,path);
+	if(dev < 0){
+		perror("UIO_RT_open");
+		return 2;
+	}
+	TEST_CHECK(rt.devices[dev].base_addr == regs);
+	TEST_CHECK_EQ(rt.devices[dev].fd,dev_fd);
+	TEST_CHECK_EQ(kernel_enabled,1);
+
+	SW_Init(&sw);
+	sw.enable(&sw);
+	sw.enableInterrupt(&sw,0xF,INT_RIS_FALL);
+	for(pin = SW0; pin <= SW3; pin++){
+		UIO_RT_register(&rt,dev,pin,&pinCallback,NULL);
+	}
+
+	/* Modalita' interrupt: un fronte, una callback, linea riarmata */
+	EMU_togglePins(&emu,SW0_MASK);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	TEST_CHECK_EQ(callbacks,1);
+	TEST_CHECK_EQ(kernel_enabled,1);
+	TEST_CHECK_EQ(emu.isr,0);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,10),0);
+
+	/* Fronte generato dalla callback: la linea e' gia' riarmata e il
+	   fronte e' servito al ciclo successivo */
+	callbacks = 0;
+	chain = 1;
+	EMU_togglePins(&emu,SW0_MASK);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	TEST_CHECK_EQ(callbacks,2);
+	TEST_CHECK_EQ(rt.devices[dev].stats.polled,0);
+
+	/* Fronti accumulati con la linea disabilitata: una sola interrupt, il
+	   contatore del kernel non salta (missed resta 0 con uio_pdrv_genirq)
+	   e il sovraccarico e' visibile in coalesced */
+	callbacks = 0;
+	EMU_togglePins(&emu,SW0_MASK);
+	EMU_togglePins(&emu,SW2_MASK | SW3_MASK);
+	EMU_togglePins(&emu,SW2_MASK);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	TEST_CHECK_EQ(callbacks,3);
+	TEST_CHECK_EQ(rt.devices[dev].stats.coalesced,2);
+	TEST_CHECK_EQ(rt.devices[dev].stats.missed,0);
+	TEST_CHECK_EQ(rt.devices[dev].info,kernel_count);
+
+	/* Modalita' ibrida: due eventi ravvicinati portano il budget ad almeno
+	   UIO_RT_POLL_MIN_NS (il primo, lontano dall'ultimo evento, lo annulla) */
+	UIO_RT_setPoll(&rt,2000);
+	EMU_togglePins(&emu,SW0_MASK);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	EMU_togglePins(&emu,SW0_MASK);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	TEST_CHECK(rt.poll_ns >= UIO_RT_POLL_MIN_NS);
+	TEST_CHECK_EQ(kernel_enabled,1);
+
+	/* I fronti generati durante il dispatch sono serviti in attesa attiva,
+	   senza passare dal device file */
+	callbacks = 0;
+	chain = 3;
+	polled = rt.devices[dev].stats.polled;
+	EMU_togglePins(&emu,SW0_MASK);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),4);
+	TEST_CHECK_EQ(callbacks,4);
+	TEST_CHECK_EQ(rt.devices[dev].stats.polled - polled,3);
+
+	/* L'interrupt rimasta pendente nel kernel e consegnata al riarmo non
+	   trova pin: nessuna callback, linea di nuovo abilitata */
+	TEST_CHECK_EQ(UIO_RT_run(&rt,100),0);
+	TEST_CHECK_EQ(callbacks,4);
+	TEST_CHECK_EQ(kernel_enabled,1);
+	TEST_CHECK_EQ(UIO_RT_run(&rt,0),0);
+
+	/* Percentili: tempi di gestione oltre l'ultima classe dell'istogramma
+	   riportati come limite inferiore, gli altri come valore */
+	report(&rt,text,sizeof(text));
+	busy_ns = 2 * UIO_RT_HIST_BUCKETS * UIO_RT_HIST_STEP_NS;
+	for(pin = 0; pin < 4; pin++){
+		EMU_togglePins(&emu,SW2_MASK);
+		TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	}
+	busy_ns = 0;
+	report(&rt,text,sizeof(text));
+	TEST_CHECK(strstr(text,"p50 >=102.3 us p99 >=102.3 us p99.9 >=102.3 us") != NULL);
+	for(pin = 0; pin < 4; pin++){
+		EMU_togglePins(&emu,SW2_MASK);
+		TEST_CHECK_EQ(UIO_RT_run(&rt,100),1);
+	}
+	report(&rt,text,sizeof(text));
+	TEST_CHECK(strstr(text,"p50 ") != NULL && strstr(text,"p50 >=") == NULL);
+
+	/* Il budget si adatta restando entro il massimo */
+	TEST_CHECK(rt.poll_ns <= rt.poll_max_ns);
+	TEST_CHECK_EQ(rt.devices[dev].stats.missed,0);
+
+	UIO_RT_close(&rt);
+	close(kernel_fd);
+	unlink(path);
+	rmdir(dir);
+	return TEST_report("test_uio");
+}
+/**@}*/
+/**@}*/
@@ -17,6 +17,21 @@
   * 		 - OUT: generica scrittura verso i registri della periferica.
   * 		 - TEST: il driver testa le interrupt effettuando il toggle di un led
   * 		 	 alla pressione/rilascio di un bottone e/o toggling di uno switch.
+  * 		 	 Tutti i device indicati con -d sono serviti da un solo thread
+  * 		 	 mediante il runtime epoll (uio_runtime.h), che stampa ogni
+  * 		 	 REPORT_INTERVAL_MS le statistiche di ciascun device.
+  * 		 	 Con -p il runtime, dopo ogni evento, attende i fronti successivi
+  * 		 	 leggendo ISR in attesa attiva per al piu' il budget indicato.
+  * 		 	 Con -r il thread e' preparato per latenze limitate (memoria
+  * 		 	 bloccata, SCHED_FIFO, CPU dedicata anche alle interrupt dei
+  * 		 	 device) e il report riporta p50/p99/p99.9 dei tempi di gestione.
+  * 		 	 Con -w le callback sono eseguite da un pool di worker
+  * 		 	 (uio_pool.h) e il thread delle interrupt si limita ad accodarle.
+  * 		 	 La chiave di ordinamento e' il pin, quindi N worker servono
+  * 		 	 in parallelo pin diversi; il toggle del led, che legge e
+  * 		 	 riscrive DATA, e' protetto da un lock per device. Con -c ogni
+  * 		 	 callback esegue prima del toggle un lavoro simulato della
+  * 		 	 durata indicata, indipendente dai led.
   *
   * La modalita' di esecuzione e selezionata in base agli argomenti forniti a riga
   * di comando. La modalita' di default e <b>TEST</b>, altrimenti utilizzare:
@@ -29,6 +44,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -38,9 +54,14 @@
 #include "button.h"
 #include "led.h"
 #include "switch.h"
+#include "uio_runtime.h"
+#include "uio_pool.h"
 
 /* Macro ---------------------------------------------------------------------*/
 #define GPIO_MAP_SIZE 0x10000	/*!< spazio di indirizzamento del device */
+#define REPORT_INTERVAL_MS 1000	/*!< intervallo tra i report della modalita' TEST */
+#define RT_PRIORITY 80			/*!< priorita' SCHED_FIFO della modalita' realtime */
+#define WORK_KEY(dev,pin) ((unsigned)((dev) * APE_IT_MAX_PINS + (pin)))	/*!< chiave di ordinamento nel pool, una per pin */
 
 /* Typedef -------------------------------------------------------------------*/
 typedef enum {
@@ -49,16 +70,35 @@ typedef enum {
 	TEST	/*!< Modalità di test */
 }direction;
 
+/**
+  * @brief led di un device della modalita' TEST
+  */
+typedef struct {
+	led_t led;				/*!< handler dei led*/
+	pthread_mutex_t lock;	/*!< serializza i toggle, che leggono e riscrivono DATA*/
+} test_led_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t work_us;	/*!< lavoro simulato per callback in us (-c)*/
+
 /* Private function prototypes -----------------------------------------------*/
 void usage(void);
 void initScreen(void);
-void APE_IRQHandler_0(void* ptr);
+int test(char** paths,int count,uint32_t poll_us,int rt_cpu,int workers);
+void btnCallback(void* context,int pin);
+void swCallback(void* context,int pin);
+void work(uint32_t us);
 
 int main(int argc, char *argv[]){
 	int c;
 	int fd;
 	int direction=TEST;
 	char *uiod;
+	char *uiods[UIO_RT_MAX_DEVICES];
+	int ndev = 0;
+	uint32_t poll_us = 0;
+	int rt_cpu = -1;
+	int workers = 0;
 	uint32_t value = 0;
 
 	void *ptr;
@@ -68,10 +108,16 @@ int main(int argc, char *argv[]){
 
 	initScreen();
 
-	while((c = getopt(argc, argv, "d:io:h")) != -1) {
+	while((c = getopt(argc, argv, "c:d:io:p:r:w:h")) != -1) {
 		switch(c) {
+		case 'c':
+			work_us = strtoul(optarg,NULL,10);
+			break;
 		case 'd':
-			uiod=optarg;
+			if(ndev < UIO_RT_MAX_DEVICES){
+				uiods[ndev++]=optarg;
+			}
+			uiod=uiods[0];
 			break;
 		case 'i':
 			direction=IN;
@@ -80,6 +126,15 @@ int main(int argc, char *argv[]){
 			direction=OUT;
 			value = strtol(optarg,NULL,16);
 			break;
+		case 'p':
+			poll_us = strtoul(optarg,NULL,10);
+			break;
+		case 'r':
+			rt_cpu = atoi(optarg);
+			break;
+		case 'w':
+			workers = atoi(optarg);
+			break;
 		case 'h':
 			usage();
 			return 0;
@@ -91,6 +146,12 @@ int main(int argc, char *argv[]){
 
 	}
 
+	/* La modalita' di test serve tutti i device con il runtime */
+	if(direction == TEST) {
+		printf("\n\n Modalità TEST \n\n");
+		return test(uiods,ndev,poll_us,rt_cpu,workers);
+	}
+
 	/* Invoca la open sul device file */
 	fd = open(uiod, O_RDWR);
 	if (fd < 1) {
@@ -146,67 +207,6 @@ int main(int argc, char *argv[]){
 		APE_writeValue32(ptr,APE_DATA_REG,value);
 	}
 
-	/* Modalità di test */
-	if(direction == TEST) {
-		printf("\n\n Modalità TEST \n\n");
-
-		/*Dichiarazione degli handler*/
-		btn_t btn_handler;
-		switch_t sw_handler;
-		led_t led_handler;
-
-		/*Inizializzazione degli handler*/
-		BTN_Init(&btn_handler);
-		SW_Init(&sw_handler);
-		LED_Init(&led_handler);
-
-		/*Ridefinizione dei base address*/
-		btn_handler.base_addr = ptr;
-		sw_handler.base_addr = ptr;
-		led_handler.base_addr = ptr;
-
-		/*Abilitazione dei moduli*/
-		btn_handler.enable(&btn_handler);
-		sw_handler.enable(&sw_handler);
-		led_handler.enable(&led_handler);
-
-		/*Spegni tutti i led*/
-		led_handler.setLeds(&led_handler,LED_ALL_MASK);
-		APE_writeValue32(ptr,APE_DATA_REG,0x0);
-
-		for(;;){
-
-			/*Abilita interrupt su entrambi i fronti*/
-			sw_handler.enableInterrupt(&sw_handler,0xF,INT_RIS_FALL);
-			btn_handler.enableInterrupt(&btn_handler,0xF,INT_RIS_FALL);
-			value = APE_readValue32(ptr,APE_IERR_REG);
-			printf("\n\n");
-
-			/* Verifica la presenza di interrupt */
-			nb = read(fd, &info, sizeof(info));
-			if (nb == sizeof(info)) {
-
-				/* Disabilita le interrupt */
-				sw_handler.disableInterrupt(&sw_handler,0xF,INT_RIS_FALL);
-				btn_handler.disableInterrupt(&btn_handler,0xF,INT_RIS_FALL);
-
-				/* Serve le interrupt */
-				APE_IRQHandler_0(ptr);
-				printf("Switch: %08x  ",sw_handler.readStatus(&sw_handler));
-				printf("Bottoni: %08x  ",btn_handler.readStatus(&btn_handler));
-				printf("Led: %08x  ",led_handler.readStatus(&led_handler));
-
-			}
-
-			nb = write(fd, &info, sizeof(info));
-			if (nb < sizeof(info)) {
-				perror("write");
-				close(fd);
-				exit(EXIT_FAILURE);
-			}
-		}
-	}
-
 	/*Unmap della periferica*/
 	munmap(ptr, GPIO_MAP_SIZE);
 
@@ -219,10 +219,14 @@ int main(int argc, char *argv[]){
   * @retval None
   */
 void usage(){
-	printf("\n\n *argv[0] -d <UIO_DEV_FILE> -t|-i|-o <VALUE>\n");
-	printf("	-d				UIO device file. e.g. /dev/uio0\n");
+	printf("\n\n *argv[0] -d <UIO_DEV_FILE> [-d <UIO_DEV_FILE> ...] -t|-i|-o <VALUE>\n");
+	printf("	-d				UIO device file. e.g. /dev/uio0, ripetibile in modalita' TEST\n");
 	printf("	-i				Lettura dalla GPIO\n");
 	printf("	-o <VALUE>		Scrittura verso la GPIO\n");
+	printf("	-p <US>			TEST: attesa attiva su ISR dopo ogni evento, budget massimo in us\n");
+	printf("	-r <CPU>		TEST: modalita' realtime sulla CPU indicata (richiede root)\n");
+	printf("	-w <N>			TEST: esegue le callback su N worker, in parallelo tra pin diversi\n");
+	printf("	-c <US>			TEST: lavoro simulato per callback in us, indipendente dai led\n");
 	return;
 }
 
@@ -242,55 +246,168 @@ void initScreen(void){
 }
 
 /**
-  * @brief  IRQ Handler della periferica GPIO_0:
-  *			<br>Salva il valore del registro ISR.
-  *			<br>Azzera il registro ISR.
-  *			<br>Serve tutte le linee che hanno.
-  *			generato interrupt effettuando il toggle del
-  *			relativo led.
-  *			<br>Se durante l'esecuzione dovessero arrivare altre interruzioni
-  *			queste vanno a modificare nuovamente il registro ISR, facendo eseguire
-  *			nuovamente l' interrupt handler non appena questa termina.
-  * @param  ptr: puntatore all'indirizzo base della periferica ottenuto con la
-  *			mmap sul device file.
-  * @retval None
+  * @brief  modalita' TEST: serve tutti i device con il runtime. Ogni fronte
+  *			di un bottone o di uno switch effettua il toggle del led alla
+  *			medesima posizione sullo stesso device.
+  * @param  paths: device file
+  * @param  count: numero di device file
+  * @param  poll_us: budget massimo di attesa attiva in us, 0 per attendere
+  *			solo le interrupt
+  * @param  rt_cpu: CPU della modalita' realtime, -1 per disabilitarla
+  * @param  workers: numero di worker del pool, 0 per eseguire le callback
+  *			nel thread delle interrupt
+  * @retval -1 in caso di errore, altrimenti non ritorna
   */
-void APE_IRQHandler_0(void* ptr){
-
-	/* Legge il registro ISR */
-	uint32_t state = APE_readValue32((uint32_t*)ptr,APE_ICRISR_REG);
-
-	/* Azzera il registro ISR */
-	APE_writeValue32((uint32_t*)ptr,APE_ICRISR_REG,0xFFFFFFFF);
-
-	if((BTN0_MASK & state) == BTN0_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED0);
-	}
-	if((BTN1_MASK & state) == BTN1_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED1);
+int test(char** paths,int count,uint32_t poll_us,int rt_cpu,int workers){
+	static btn_t btn_handler[UIO_RT_MAX_DEVICES];
+	static switch_t sw_handler[UIO_RT_MAX_DEVICES];
+	static test_led_t led_handler[UIO_RT_MAX_DEVICES];
+	static uio_pool_t pool;
+	uio_rt_t rt;
+	int dev;
+	int pin;
+	int i;
+
+	if(count == 0){
+		printf("Nessun device file indicato.\n");
+		usage();
+		return -1;
 	}
-	if((BTN2_MASK & state) == BTN2_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED2);
+	if(UIO_RT_Init(&rt) < 0){
+		perror("epoll");
+		return -1;
 	}
-	if((BTN3_MASK & state) == BTN3_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED3);
+	UIO_RT_setPoll(&rt,poll_us);
+	if(workers > 0 && UIO_POOL_Init(&pool,workers) < 0){
+		perror("pool");
+		UIO_RT_close(&rt);
+		return -1;
 	}
 
-	if((SW0_MASK & state) == SW0_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED0);
+	for(i = 0; i < count; i++){
+		dev = UIO_RT_open(&rt,paths[i]);
+		if(dev < 0){
+			perror(paths[i]);
+			printf("Device file non valido:%s.\n", paths[i]);
+			if(workers > 0){
+				UIO_POOL_stop(&pool);
+			}
+			UIO_RT_close(&rt);
+			usage();
+			return -1;
+		}
+
+		/*Inizializzazione degli handler*/
+		BTN_Init(&btn_handler[dev]);
+		SW_Init(&sw_handler[dev]);
+		LED_Init(&led_handler[dev].led);
+		pthread_mutex_init(&led_handler[dev].lock,NULL);
+
+		/*Ridefinizione dei base address*/
+		btn_handler[dev].base_addr = rt.devices[dev].base_addr;
+		sw_handler[dev].base_addr = rt.devices[dev].base_addr;
+		led_handler[dev].led.base_addr = rt.devices[dev].base_addr;
+
+		/*Abilitazione dei moduli*/
+		btn_handler[dev].enable(&btn_handler[dev]);
+		sw_handler[dev].enable(&sw_handler[dev]);
+		led_handler[dev].led.enable(&led_handler[dev].led);
+
+		/*Spegni tutti i led*/
+		led_handler[dev].led.setLeds(&led_handler[dev].led,LED_ALL_MASK);
+		APE_writeValue32(rt.devices[dev].base_addr,APE_DATA_REG,0x0);
+
+		/*Ogni bottone e ogni switch effettua il toggle del led corrispondente;
+		 *nel pool la chiave e' il pin: i toggle dello stesso device sono
+		 *serializzati dal lock, il resto della callback procede in parallelo*/
+		for(pin = 0; pin < 4; pin++){
+			if(workers > 0){
+				UIO_POOL_register(&pool,&rt,dev,BTN0 + pin,WORK_KEY(dev,BTN0 + pin),&btnCallback,&led_handler[dev]);
+				UIO_POOL_register(&pool,&rt,dev,SW0 + pin,WORK_KEY(dev,SW0 + pin),&swCallback,&led_handler[dev]);
+			}else{
+				UIO_RT_register(&rt,dev,BTN0 + pin,&btnCallback,&led_handler[dev]);
+				UIO_RT_register(&rt,dev,SW0 + pin,&swCallback,&led_handler[dev]);
+			}
+		}
+
+		/*Abilita interrupt su entrambi i fronti: ISR e' azzerato dal runtime*/
+		sw_handler[dev].enableInterrupt(&sw_handler[dev],0xF,INT_RIS_FALL);
+		btn_handler[dev].enableInterrupt(&btn_handler[dev],0xF,INT_RIS_FALL);
 	}
-	if((SW1_MASK & state) == SW1_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED1);
+
+	/*Blocca la memoria e fissa thread e interrupt sulla CPU indicata*/
+	if(rt_cpu >= 0 && UIO_RT_realtime(&rt,rt_cpu,RT_PRIORITY) < 0){
+		if(workers > 0){
+			UIO_POOL_stop(&pool);
+		}
+		UIO_RT_close(&rt);
+		return -1;
 	}
-	if((SW2_MASK & state) == SW2_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED2);
+
+	for(;;){
+		if(UIO_RT_run(&rt,REPORT_INTERVAL_MS) < 0){
+			perror("uio");
+			if(workers > 0){
+				UIO_POOL_stop(&pool);
+			}
+			UIO_RT_close(&rt);
+			return -1;
+		}
+		if(UIO_RT_report(&rt,REPORT_INTERVAL_MS) && workers > 0){
+			UIO_POOL_report(&pool);
+		}
 	}
-	if((SW3_MASK & state) == SW3_MASK){
-		APE_toggleBit((uint32_t*)ptr,APE_DATA_REG,LED3);
+}
+
+/**
+  * @brief  lavoro simulato di una callback: attesa attiva della durata
+  *			indicata, senza accessi alla periferica.
+  * @param  us: durata in us, 0 per nessun lavoro
+  * @retval None
+  */
+void work(uint32_t us){
+	struct timespec start;
+	struct timespec now;
+
+	if(us == 0){
+		return;
 	}
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	do{
+		clock_gettime(CLOCK_MONOTONIC,&now);
+	}while((now.tv_sec - start.tv_sec) * 1000000LL + (now.tv_nsec - start.tv_nsec) / 1000 < us);
+}
+
+/**
+  * @brief  callback dei bottoni: esegue il lavoro simulato, poi effettua il
+  *			toggle del led alla medesima posizione.
+  * @param  context: puntatore ai led del device
+  * @param  pin: posizione del bottone
+  * @retval None
+  */
+void btnCallback(void* context,int pin){
+	test_led_t* leds = context;
 
-	/* ----------------------------- */
+	work(work_us);
+	pthread_mutex_lock(&leds->lock);
+	leds->led.toggle(&leds->led,(led_n)(LED0 + pin - BTN0));
+	pthread_mutex_unlock(&leds->lock);
+}
+
+/**
+  * @brief  callback degli switch: esegue il lavoro simulato, poi effettua il
+  *			toggle del led alla medesima posizione.
+  * @param  context: puntatore ai led del device
+  * @param  pin: posizione dello switch
+  * @retval None
+  */
+void swCallback(void* context,int pin){
+	test_led_t* leds = context;
 
+	work(work_us);
+	pthread_mutex_lock(&leds->lock);
+	leds->led.toggle(&leds->led,(led_n)(LED0 + pin - SW0));
+	pthread_mutex_unlock(&leds->lock);
 }
 /**@}*/
-/**@}*/
\ No newline at end of file
+/**@}*/
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * @file    uio_pool.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa il pool di worker del driver UIO.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup UIO
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <errno.h>
+#include "uio_pool.h"
+
+/**
+  * @brief  incrementa un contatore con un solo scrittore: lettura e
+  * 		scrittura atomiche, senza operazione read-modify-write
+  * @param  counter: contatore
+  * @retval None
+  */
+static inline void UIO_POOL_count(atomic_uint_least64_t* counter){
+	atomic_store_explicit(counter,atomic_load_explicit(counter,memory_order_relaxed) + 1,memory_order_relaxed);
+}
+
+/**
+  * @brief  callback registrata nella tabella del device: accoda il pin al
+  * 		worker della callback, nel thread del runtime
+  * @param  context: puntatore alla uio_pool_binding_t
+  * @param  pin: posizione del pin
+  * @retval None
+  */
+static void UIO_POOL_submit(void* context,int pin){
+	uio_pool_binding_t* binding = context;
+	uio_pool_worker_t* w = &binding->pool->workers[binding->worker];
+	unsigned head = atomic_load_explicit(&w->head,memory_order_relaxed);
+
+	if(head - atomic_load_explicit(&w->tail,memory_order_acquire) >= UIO_POOL_RING_SIZE){
+		UIO_POOL_count(&w->dropped);
+		return;
+	}
+	w->buf[head & (UIO_POOL_RING_SIZE - 1)] = (uio_pool_job_t){ binding, pin };
+	atomic_store_explicit(&w->head,head + 1,memory_order_release);
+	sem_post(&w->ready);
+}
+
+/**
+  * @brief  thread di un worker: esegue in ordine gli eventi della sua coda
+  * @param  arg: puntatore al worker
+  * @retval NULL
+  */
+static void* UIO_POOL_worker(void* arg){
+	uio_pool_worker_t* w = arg;
+	uio_pool_job_t job;
+	unsigned tail;
+
+	for(;;){
+		if(sem_wait(&w->ready) < 0){
+			continue;
+		}
+		tail = atomic_load_explicit(&w->tail,memory_order_relaxed);
+		if(tail == atomic_load_explicit(&w->head,memory_order_acquire)){
+			/* Risveglio di UIO_POOL_stop */
+			if(!atomic_load(&w->pool->running)){
+				break;
+			}
+			continue;
+		}
+		job = w->buf[tail & (UIO_POOL_RING_SIZE - 1)];
+		atomic_store_explicit(&w->tail,tail + 1,memory_order_release);
+
+		job.binding->callback(job.binding->context,job.pin);
+		UIO_POOL_count(&w->executed);
+	}
+	return NULL;
+}
+
+/**
+  * @brief  avvia i worker del pool
+  * @param  self: puntatore al pool
+  * @param  count: numero di worker, da 1 a UIO_POOL_MAX_WORKERS
+  * @retval 0 oppure -1 in caso di errore (i worker avviati sono terminati)
+  */
+int UIO_POOL_Init(uio_pool_t* self,int count){
+	int i;
+
+	if(count < 1 || count > UIO_POOL_MAX_WORKERS){
+		errno = EINVAL;
+		return -1;
+	}
+	self->count = 0;
+	atomic_store(&self->running,1);
+
+	for(i = 0; i < count; i++){
+		uio_pool_worker_t* w = &self->workers[i];
+
+		atomic_store(&w->head,0);
+		atomic_store(&w->tail,0);
+		atomic_store(&w->dropped,0);
+		atomic_store(&w->executed,0);
+		w->pool = self;
+		if(sem_init(&w->ready,0,0) < 0){
+			UIO_POOL_stop(self);
+			return -1;
+		}
+		if(pthread_create(&w->thread,NULL,&UIO_POOL_worker,w) != 0){
+			sem_destroy(&w->ready);
+			UIO_POOL_stop(self);
+			return -1;
+		}
+		self->count++;
+	}
+	return 0;
+}
+
+/**
+  * @brief  registra la callback di un pin di un device, eseguita dal pool
+  * @param  self: puntatore al pool
+  * @param  rt: runtime a cui appartiene il device
+  * @param  dev: indice del device
+  * @param  pin: posizione del pin
+  * @param  key: chiave di ordinamento, gli eventi con la stessa chiave sono
+  * 		eseguiti in ordine dallo stesso worker (es. il pin)
+  * @param  callback: funzione da invocare
+  * @param  context: argomento passato alla funzione
+  * @retval None
+  */
+void UIO_POOL_register(uio_pool_t* self,uio_rt_t* rt,int dev,int pin,unsigned key,APE_IT_callback_t callback,void* context){
+	uio_pool_binding_t* binding = &self->bindings[dev][pin];
+
+	binding->pool = self;
+	binding->callback = callback;
+	binding->context = context;
+	binding->worker = key % self->count;
+	UIO_RT_register(rt,dev,pin,&UIO_POOL_submit,binding);
+}
+
+/**
+  * @brief  stampa callback eseguite ed eventi scartati da ogni worker
+  * @param  self: puntatore al pool
+  * @retval None
+  */
+void UIO_POOL_report(uio_pool_t* self){
+	int i;
+
+	for(i = 0; i < self->count; i++){
+		printf("worker %d: eseguite %llu scartate %llu in coda %u\n",
+				i,
+				(unsigned long long)atomic_load_explicit(&self->workers[i].executed,memory_order_relaxed),
+				(unsigned long long)atomic_load_explicit(&self->workers[i].dropped,memory_order_relaxed),
+				atomic_load(&self->workers[i].head) - atomic_load(&self->workers[i].tail));
+	}
+}
+
+/**
+  * @brief  termina i worker dopo che hanno svuotato le proprie code; le
+  * 		callback registrate non devono piu' essere invocate dal runtime
+  * @param  self: puntatore al pool
+  * @retval None
+  */
+void UIO_POOL_stop(uio_pool_t* self){
+	int i;
+
+	atomic_store(&self->running,0);
+	for(i = 0; i < self->count; i++){
+		sem_post(&self->workers[i].ready);
+	}
+	for(i = 0; i < self->count; i++){
+		pthread_join(self->workers[i].thread,NULL);
+		sem_destroy(&self->workers[i].ready);
+	}
+	self->count = 0;
+}
+/**@}*/
+/**@}*/
@@ -0,0 +1,101 @@
+/**
+  ******************************************************************************
+  * @file    uio_pool.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce il pool di worker del driver UIO.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup UIO
+  * @{
+  * @brief   Esecuzione delle callback del runtime UIO su un pool di thread.
+  * @details UIO_POOL_register registra nella tabella del device, al posto
+  * 		 della callback, una funzione che accoda il pin al worker scelto dalla
+  * 		 chiave di ordinamento (chiave modulo numero di worker): il thread del
+  * 		 runtime torna subito ad attendere le interrupt e gli eventi con la
+  * 		 stessa chiave sono eseguiti dallo stesso worker, nell'ordine di arrivo.
+  * 		 Usando il pin come chiave si ottiene l'ordine per pin; callback che
+  * 		 modificano lo stesso registro (es. DATA con lettura-modifica-scrittura)
+  * 		 vanno registrate con la stessa chiave, oppure devono proteggere
+  * 		 l'accesso con un lock se il resto del lavoro puo' procedere in
+  * 		 parallelo.
+  * 		 Ogni worker ha una coda a singolo produttore e singolo consumatore,
+  * 		 senza lock, e un semaforo su cui dorme quando la coda e' vuota
+  * 		 (sem_post entra nel kernel solo se il worker sta dormendo). A coda
+  * 		 piena l'evento e' scartato e contato in dropped. I contatori dropped
+  * 		 ed executed hanno un solo scrittore e sono atomici con ordinamento
+  * 		 relaxed: UIO_POOL_report puo' leggerli da un altro thread.
+  * 		 Il driver va collegato con -lpthread.
+  ******************************************************************************
+  */
+#ifndef SRC_UIO_POOL_H_
+#define SRC_UIO_POOL_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "uio_runtime.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define UIO_POOL_MAX_WORKERS	8	/*!< numero massimo di worker*/
+#define UIO_POOL_RING_SIZE		256	/*!< eventi per coda, potenza di 2*/
+#define UIO_POOL_CACHE_LINE		64	/*!< separazione degli indici delle code*/
+
+/* Typedef -------------------------------------------------------------------*/
+typedef struct uio_pool_t uio_pool_t;
+
+/**
+  * @brief callback di un pin eseguita dal pool
+  */
+typedef struct {
+	uio_pool_t* pool;			/*!< pool di appartenenza*/
+	APE_IT_callback_t callback;	/*!< funzione da invocare*/
+	void* context;				/*!< argomento passato alla funzione*/
+	int worker;					/*!< worker che esegue la funzione*/
+} uio_pool_binding_t;
+
+/**
+  * @brief evento accodato a un worker
+  */
+typedef struct {
+	uio_pool_binding_t* binding;	/*!< callback da invocare*/
+	int pin;						/*!< posizione del pin*/
+} uio_pool_job_t;
+
+/**
+  * @brief worker e relativa coda
+  */
+typedef struct {
+	_Alignas(UIO_POOL_CACHE_LINE) atomic_uint head;	/*!< eventi accodati, modificato solo dal runtime*/
+	atomic_uint_least64_t dropped;					/*!< eventi scartati a coda piena, modificato solo dal runtime*/
+	_Alignas(UIO_POOL_CACHE_LINE) atomic_uint tail;	/*!< eventi estratti, modificato solo dal worker*/
+	atomic_uint_least64_t executed;					/*!< callback eseguite, modificato solo dal worker*/
+	sem_t ready;									/*!< eventi disponibili*/
+	pthread_t thread;								/*!< thread del worker*/
+	uio_pool_t* pool;								/*!< pool di appartenenza*/
+	uio_pool_job_t buf[UIO_POOL_RING_SIZE];			/*!< coda degli eventi*/
+} uio_pool_worker_t;
+
+/**
+  * @brief pool di worker
+  */
+struct uio_pool_t {
+	int count;														/*!< worker avviati*/
+	atomic_int running;												/*!< 0 per terminare i worker*/
+	uio_pool_worker_t workers[UIO_POOL_MAX_WORKERS];				/*!< worker*/
+	uio_pool_binding_t bindings[UIO_RT_MAX_DEVICES][APE_IT_MAX_PINS];	/*!< callback per device e pin*/
+};
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+int UIO_POOL_Init(uio_pool_t*,int);
+void UIO_POOL_register(uio_pool_t*,uio_rt_t*,int,int,unsigned,APE_IT_callback_t,void*);
+void UIO_POOL_report(uio_pool_t*);
+void UIO_POOL_stop(uio_pool_t*);
+
+#endif /* SRC_UIO_POOL_H_ */
+/**@}*/
+/**@}*/
@@ -0,0 +1,591 @@
+/**
+  ******************************************************************************
+  * @file    uio_runtime.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa il runtime multi-periferica del driver UIO.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup UIO
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE		/*!< CPU_SET e sched_setaffinity*/
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/epoll.h>
+
+#include "uio_runtime.h"
+#include "gpio_LL_inline.h"
+#include "gpio_shadow.h"
+
+#define UIO_RT_HIST_OVERFLOW	UINT32_MAX	/*!< percentile nella classe dei valori fuori scala*/
+
+/**
+  * @brief  differenza in nanosecondi tra due istanti
+  * @param  from: istante iniziale
+  * @param  to: istante finale
+  * @retval to - from in nanosecondi
+  */
+static int64_t UIO_RT_elapsed(const struct timespec* from,const struct timespec* to){
+	return (int64_t)(to->tv_sec - from->tv_sec) * 1000000000LL + (to->tv_nsec - from->tv_nsec);
+}
+
+/**
+  * @brief  riabilita la linea di interrupt del device nel kernel
+  * @param  dev: puntatore al device
+  * @retval 0 oppure -1 se la scrittura fallisce
+  */
+static int UIO_RT_arm(uio_rt_device_t* dev){
+	uint32_t enable = 1;
+
+	if(write(dev->fd,&enable,sizeof(enable)) != sizeof(enable)){
+		return -1;
+	}
+	dev->armed = 1;
+	return 0;
+}
+
+/**
+  * @brief  invoca le callback dei pin pendenti e aggiorna le statistiche
+  * @param  dev: puntatore al device
+  * @param  pending: pin pendenti, gia' azzerati in ISR
+  * @param  since: istante da cui misurare il tempo di gestione
+  * @retval None
+  */
+static void UIO_RT_dispatch(uio_rt_device_t* dev,uint32_t pending,const struct timespec* since){
+	struct timespec now;
+	int64_t ns;
+	int64_t bucket;
+
+	dev->table.event.pending = pending;
+	APE_IT_dispatch(&dev->table,pending);
+
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	ns = UIO_RT_elapsed(since,&now);
+	dev->stats.events++;
+	dev->stats.pins += __builtin_popcount(pending);
+	dev->stats.coalesced += __builtin_popcount(pending) - 1;
+	dev->stats.total_ns += ns;
+	if(ns > dev->stats.max_ns){
+		dev->stats.max_ns = ns;
+	}
+	bucket = ns / UIO_RT_HIST_STEP_NS;
+	dev->hist[(bucket < UIO_RT_HIST_BUCKETS) ? bucket : UIO_RT_HIST_BUCKETS - 1]++;
+}
+
+/**
+  * @brief  ricava un percentile dall'istogramma dei tempi di gestione
+  * @param  hist: istogramma
+  * @param  count: campioni nell'istogramma, almeno 1
+  * @param  fraction: percentile richiesto, es. 0.99
+  * @retval estremo superiore in ns della classe che contiene il percentile,
+  * 		UIO_RT_HIST_OVERFLOW se cade nell'ultima classe
+  */
+static uint32_t UIO_RT_percentile(const uint32_t* hist,uint64_t count,double fraction){
+	uint64_t rank = (uint64_t)(fraction * (count - 1)) + 1;
+	uint64_t seen = 0;
+	int i;
+
+	for(i = 0; i < UIO_RT_HIST_BUCKETS - 1; i++){
+		seen += hist[i];
+		if(seen >= rank){
+			return (i + 1) * UIO_RT_HIST_STEP_NS;
+		}
+	}
+	return UIO_RT_HIST_OVERFLOW;
+}
+
+/**
+  * @brief  scrive un percentile in us, o il limite dell'istogramma se il
+  * 		percentile e' fuori scala
+  * @param  buf: destinazione
+  * @param  len: dimensione di buf
+  * @param  ns: valore restituito da UIO_RT_percentile
+  * @retval buf
+  */
+static const char* UIO_RT_formatUs(char* buf,size_t len,uint32_t ns){
+	if(ns == UIO_RT_HIST_OVERFLOW){
+		snprintf(buf,len,">=%.1f",(UIO_RT_HIST_BUCKETS - 1) * UIO_RT_HIST_STEP_NS / 1e3);
+	}else{
+		snprintf(buf,len,"%.1f",ns / 1e3);
+	}
+	return buf;
+}
+
+/**
+  * @brief  individua la linea di interrupt di un device UIO cercando il suo
+  * 		nome (/sys/class/uio/uioN/name) in /proc/interrupts
+  * @param  path: device file, es. /dev/uio0
+  * @retval numero della linea, -1 se non trovata
+  */
+static int UIO_RT_irq(const char* path){
+	const char* dev = strrchr(path,'/');
+	char name[64];
+	char line[512];
+	size_t len;
+	int irq = -1;
+	FILE* f;
+
+	snprintf(line,sizeof(line),"/sys/class/uio/%s/name",(dev != NULL) ? dev + 1 : path);
+	f = fopen(line,"r");
+	if(f == NULL){
+		return -1;
+	}
+	if(fgets(name,sizeof(name),f) == NULL){
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+	name[strcspn(name,"\n")] = '\0';
+	len = strlen(name);
+
+	f = fopen("/proc/interrupts","r");
+	if(f == NULL){
+		return -1;
+	}
+	while(irq < 0 && fgets(line,sizeof(line),f) != NULL){
+		size_t n = strcspn(line,"\n");
+		int id;
+
+		line[n] = '\0';
+		if(n > len && line[n - len - 1] == ' ' && strcmp(&line[n - len],name) == 0 && sscanf(line," %d:",&id) == 1){
+			irq = id;
+		}
+	}
+	fclose(f);
+	return irq;
+}
+
+/**
+  * @brief  dirige una linea di interrupt verso una CPU
+  * @param  irq: numero della linea
+  * @param  cpu: CPU di destinazione, minore di 32
+  * @retval 0 oppure -1 in caso di errore
+  */
+static int UIO_RT_steerIrq(int irq,int cpu){
+	char path[64];
+	FILE* f;
+	int ret;
+
+	snprintf(path,sizeof(path),"/proc/irq/%d/smp_affinity",irq);
+	f = fopen(path,"w");
+	if(f == NULL){
+		return -1;
+	}
+	ret = fprintf(f,"%x\n",1u << cpu);
+	return (fclose(f) == 0 && ret > 0) ? 0 : -1;
+}
+
+/**
+  * @brief  porta in memoria le pagine dello stack che il thread potra' usare,
+  * 		scrivendo un byte per pagina. Le scritture passano da un puntatore
+  * 		volatile e la funzione non e' espansa nel chiamante, quindi il
+  * 		compilatore non puo' eliminarle ne' ridurre il frame.
+  * @retval None
+  */
+static void __attribute__((noinline)) UIO_RT_prefault(void){
+	uint8_t stack[UIO_RT_PREFAULT_STACK];
+	volatile uint8_t* page = stack;
+	long size = sysconf(_SC_PAGESIZE);
+	size_t i;
+
+	if(size <= 0){
+		size = 4096;
+	}
+	for(i = 0; i < sizeof(stack); i += size){
+		page[i] = 0;
+	}
+}
+
+/**
+  * @brief  serve un device leggendone direttamente ISR, senza passare dal kernel
+  * @param  dev: puntatore al device
+  * @param  detected: istante della lettura
+  * @retval 1 se c'erano pin pendenti, 0 altrimenti
+  */
+static int UIO_RT_poll(uio_rt_device_t* dev,const struct timespec* detected){
+	uint32_t pending = APE_READ32(dev->base_addr,APE_ICRISR_REG);
+
+	if(pending == 0){
+		return 0;
+	}
+	APE_WRITE32(dev->base_addr,APE_ICRISR_REG,pending);
+	UIO_RT_dispatch(dev,pending,detected);
+	dev->stats.polled++;
+	return 1;
+}
+
+/**
+  * @brief  adatta il budget di attesa attiva al tempo trascorso tra
+  * 		l'ultimo evento e un risveglio da epoll_wait
+  * @param  self: puntatore al runtime
+  * @param  gap: tempo trascorso in nanosecondi
+  * @retval None
+  */
+static void UIO_RT_adapt(uio_rt_t* self,int64_t gap){
+	if(gap > self->poll_max_ns){
+		/* L'attesa attiva non avrebbe intercettato l'evento */
+		self->poll_ns /= 2;
+		if(self->poll_ns < UIO_RT_POLL_MIN_NS){
+			self->poll_ns = 0;
+		}
+	}else if(gap > self->poll_ns){
+		/* Un budget maggiore avrebbe evitato il risveglio */
+		self->poll_ns = (self->poll_ns == 0) ? UIO_RT_POLL_MIN_NS : self->poll_ns * 2;
+		if(self->poll_ns > self->poll_max_ns){
+			self->poll_ns = self->poll_max_ns;
+		}
+	}
+}
+
+/**
+  * @brief  attende in modo attivo nuovi fronti su tutti i device finche'
+  * 		non trascorre il budget senza eventi, poi riarma le linee
+  * @param  self: puntatore al runtime
+  * @retval numero di interrupt servite, -1 in caso di errore
+  */
+static int UIO_RT_spin(uio_rt_t* self){
+	struct timespec start;
+	struct timespec now;
+	int served = 0;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	now = start;
+	while(UIO_RT_elapsed(&start,&now) < self->poll_ns){
+		for(i = 0; i < self->count; i++){
+			if(UIO_RT_poll(&self->devices[i],&now)){
+				served++;
+				self->last_event = now;
+				start = now;
+			}
+		}
+		clock_gettime(CLOCK_MONOTONIC,&now);
+	}
+
+	/* Riarma le linee e serve i fronti arrivati prima del riarmo, che non
+	 * genererebbero un nuovo fronte della linea di interrupt */
+	for(i = 0; i < self->count; i++){
+		uio_rt_device_t* dev = &self->devices[i];
+
+		if(!dev->armed && UIO_RT_arm(dev) < 0){
+			return -1;
+		}
+		clock_gettime(CLOCK_MONOTONIC,&now);
+		served += UIO_RT_poll(dev,&now);
+	}
+	return served;
+}
+
+/**
+  * @brief  serve un device segnalato pronto da epoll
+  * @param  dev: puntatore al device
+  * @param  wakeup: istante del risveglio di epoll_wait
+  * @param  rearm: 1 per riarmare subito la linea, 0 se sara' riarmata al
+  * 		termine dell'attesa attiva
+  * @retval 1 se l'interrupt e' stata servita, 0 se non c'era, -1 in caso di errore
+  */
+static int UIO_RT_serve(uio_rt_device_t* dev,const struct timespec* wakeup,int rearm){
+	uint32_t pending;
+	uint32_t info;
+
+	/* Consuma l'evento del kernel, che ha disabilitato la linea */
+	if(read(dev->fd,&info,sizeof(info)) != sizeof(info)){
+		return (errno == EAGAIN) ? 0 : -1;
+	}
+	dev->armed = 0;
+	pending = APE_READ32(dev->base_addr,APE_ICRISR_REG);
+
+	/* Un salto del contatore indica interrupt non lette singolarmente */
+	if(dev->synced && info - dev->info > 1){
+		dev->stats.missed += info - dev->info - 1;
+		dev->gap_info = info;
+		dev->gap_isr = pending;
+	}
+	dev->info = info;
+	dev->synced = 1;
+
+	/* Azzera i soli bit letti e, fuori dalla modalita' ibrida, riarma
+	 * subito la linea */
+	APE_WRITE32(dev->base_addr,APE_ICRISR_REG,pending);
+	if(rearm && UIO_RT_arm(dev) < 0){
+		return -1;
+	}
+
+	/* Fronti gia' serviti in attesa attiva */
+	if(pending == 0){
+		return 0;
+	}
+	UIO_RT_dispatch(dev,pending,wakeup);
+	return 1;
+}
+
+/**
+  * @brief  inizializza un runtime senza device
+  * @param  self: puntatore al runtime
+  * @retval 0 oppure -1 se l'insieme epoll non puo' essere creato
+  */
+int UIO_RT_Init(uio_rt_t* self){
+	self->count = 0;
+	self->poll_max_ns = 0;
+	self->poll_ns = 0;
+	self->epfd = epoll_create1(EPOLL_CLOEXEC);
+	clock_gettime(CLOCK_MONOTONIC,&self->last_report);
+	self->last_event = self->last_report;
+	return (self->epfd < 0) ? -1 : 0;
+}
+
+/**
+  * @brief  apre e mappa un device UIO, lo aggiunge all'insieme epoll e ne
+  * 		abilita la linea di interrupt; la tabella delle callback e' vuota
+  * @param  self: puntatore al runtime
+  * @param  path: device file, es. /dev/uio0
+  * @retval indice del device oppure -1 in caso di errore
+  */
+int UIO_RT_open(uio_rt_t* self,const char* path){
+	uio_rt_device_t* dev;
+	struct epoll_event ev;
+	void* ptr;
+
+	if(self->count >= UIO_RT_MAX_DEVICES){
+		return -1;
+	}
+	dev = &self->devices[self->count];
+
+	dev->fd = open(path,O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if(dev->fd < 0){
+		return -1;
+	}
+	ptr = mmap(NULL,UIO_RT_MAP_SIZE,PROT_READ | PROT_WRITE,MAP_SHARED,dev->fd,0);
+	if(ptr == MAP_FAILED){
+		close(dev->fd);
+		return -1;
+	}
+
+	dev->path = path;
+	dev->base_addr = ptr;
+	dev->info = 0;
+	dev->synced = 0;
+	dev->gap_info = 0;
+	dev->gap_isr = 0;
+	dev->armed = 0;
+	APE_IT_Init(&dev->table,dev->base_addr);
+	dev->stats = (uio_rt_stats_t){ 0 };
+	dev->last = dev->stats;
+	memset(dev->hist,0,sizeof(dev->hist));
+
+	ev.events = EPOLLIN;
+	ev.data.u32 = self->count;
+	if(epoll_ctl(self->epfd,EPOLL_CTL_ADD,dev->fd,&ev) < 0 || UIO_RT_arm(dev) < 0){
+		munmap(ptr,UIO_RT_MAP_SIZE);
+		close(dev->fd);
+		return -1;
+	}
+	return self->count++;
+}
+
+/**
+  * @brief  registra la callback di un pin di un device
+  * @param  self: puntatore al runtime
+  * @param  dev: indice del device
+  * @param  pin: posizione del pin
+  * @param  callback: funzione da invocare
+  * @param  context: argomento passato alla funzione
+  * @retval None
+  */
+void UIO_RT_register(uio_rt_t* self,int dev,int pin,APE_IT_callback_t callback,void* context){
+	APE_IT_register(&self->devices[dev].table,pin,callback,context);
+}
+
+/**
+  * @brief  abilita la modalita' ibrida con attesa attiva su ISR dopo ogni
+  * 		evento
+  * @param  self: puntatore al runtime
+  * @param  max_us: budget massimo di attesa attiva in us, 0 per disabilitarla
+  * @retval None
+  */
+void UIO_RT_setPoll(uio_rt_t* self,uint32_t max_us){
+	self->poll_max_ns = max_us * 1000;
+	self->poll_ns = (self->poll_max_ns < UIO_RT_POLL_MIN_NS) ? self->poll_max_ns : UIO_RT_POLL_MIN_NS;
+}
+
+/**
+  * @brief  prepara il thread chiamante per latenze limitate; va chiamata
+  * 		dopo aver aperto i device. Richiede i privilegi di root (o
+  * 		CAP_SYS_NICE, CAP_IPC_LOCK e scrittura su /proc/irq).
+  * @param  self: puntatore al runtime
+  * @param  cpu: CPU su cui fissare il thread e le interrupt, minore di 32
+  * @param  priority: priorita' SCHED_FIFO
+  * @retval 0, oppure -1 al primo passo fallito (segnalato con perror)
+  */
+int UIO_RT_realtime(uio_rt_t* self,int cpu,int priority){
+	struct sched_param param;
+	cpu_set_t set;
+	int irq;
+	int i;
+
+	/* Nessun page fault durante la gestione delle interrupt */
+	if(mlockall(MCL_CURRENT | MCL_FUTURE) < 0){
+		perror("mlockall");
+		return -1;
+	}
+	UIO_RT_prefault();
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu,&set);
+	if(sched_setaffinity(0,sizeof(set),&set) < 0){
+		perror("sched_setaffinity");
+		return -1;
+	}
+
+	param.sched_priority = priority;
+	if(sched_setscheduler(0,SCHED_FIFO,&param) < 0){
+		perror("sched_setscheduler");
+		return -1;
+	}
+
+	/* Le interrupt dei device sono gestite dalla CPU del thread */
+	for(i = 0; i < self->count; i++){
+		irq = UIO_RT_irq(self->devices[i].path);
+		if(irq < 0){
+			fprintf(stderr,"%s: linea di interrupt non trovata\n",self->devices[i].path);
+			return -1;
+		}
+		if(UIO_RT_steerIrq(irq,cpu) < 0){
+			perror("smp_affinity");
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/**
+  * @brief  attende le interrupt di tutti i device e serve quelli pronti
+  * @param  self: puntatore al runtime
+  * @param  timeout_ms: attesa massima in ms, -1 per attendere senza limite
+  * @retval numero di device serviti (0 allo scadere dell'attesa o se
+  * 		interrotta da un segnale), -1 in caso di errore
+  */
+int UIO_RT_run(uio_rt_t* self,int timeout_ms){
+	struct epoll_event ev[UIO_RT_MAX_DEVICES];
+	struct timespec wakeup;
+	int served = 0;
+	int n;
+	int i;
+
+	n = epoll_wait(self->epfd,ev,UIO_RT_MAX_DEVICES,timeout_ms);
+	if(n < 0){
+		return (errno == EINTR) ? 0 : -1;
+	}
+	clock_gettime(CLOCK_MONOTONIC,&wakeup);
+
+	for(i = 0; i < n; i++){
+		int r = UIO_RT_serve(&self->devices[ev[i].data.u32],&wakeup,self->poll_max_ns == 0);
+
+		if(r < 0){
+			return -1;
+		}
+		served += r;
+	}
+
+	/* Modalita' ibrida: adatta il budget e attende altri fronti */
+	if(self->poll_max_ns > 0 && n > 0){
+		int polled;
+
+		UIO_RT_adapt(self,UIO_RT_elapsed(&self->last_event,&wakeup));
+		self->last_event = wakeup;
+		polled = UIO_RT_spin(self);
+		if(polled < 0){
+			return -1;
+		}
+		served += polled;
+	}
+	return served;
+}
+
+/**
+  * @brief  stampa le statistiche di ogni device dall'ultimo report, se e'
+  * 		trascorso almeno l'intervallo indicato
+  * @param  self: puntatore al runtime
+  * @param  interval_ms: intervallo minimo tra due report
+  * @retval 1 se il report e' stato stampato, 0 altrimenti
+  */
+int UIO_RT_report(uio_rt_t* self,int interval_ms){
+	struct timespec now;
+	double seconds;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	seconds = UIO_RT_elapsed(&self->last_report,&now) / 1e9;
+	if(seconds * 1000 < interval_ms){
+		return 0;
+	}
+
+	for(i = 0; i < self->count; i++){
+		uio_rt_device_t* dev = &self->devices[i];
+		uint64_t events = dev->stats.events - dev->last.events;
+		uint64_t pins = dev->stats.pins - dev->last.pins;
+		uint64_t ns = dev->stats.total_ns - dev->last.total_ns;
+
+		printf("%s: %.0f int/s (%.0f%% in attesa attiva) %.0f pin/s gestione media %.1f us max %.1f us\n",
+				dev->path,
+				events / seconds,
+				(events > 0) ? 100.0 * (dev->stats.polled - dev->last.polled) / events : 0.0,
+				pins / seconds,
+				(events > 0) ? ns / 1e3 / events : 0.0,
+				dev->stats.max_ns / 1e3);
+		if(events > 0){
+			char p50[16];
+			char p99[16];
+			char p999[16];
+
+			printf("%s: gestione p50 %s us p99 %s us p99.9 %s us\n",
+					dev->path,
+					UIO_RT_formatUs(p50,sizeof(p50),UIO_RT_percentile(dev->hist,events,0.50)),
+					UIO_RT_formatUs(p99,sizeof(p99),UIO_RT_percentile(dev->hist,events,0.99)),
+					UIO_RT_formatUs(p999,sizeof(p999),UIO_RT_percentile(dev->hist,events,0.999)));
+		}
+		if(dev->stats.missed != dev->last.missed || dev->stats.coalesced != dev->last.coalesced){
+			printf("%s: interrupt perse %llu, pin coalescenti %llu (ultimo salto: contatore %u ISR %08x)\n",
+					dev->path,
+					(unsigned long long)(dev->stats.missed - dev->last.missed),
+					(unsigned long long)(dev->stats.coalesced - dev->last.coalesced),
+					dev->gap_info,
+					dev->gap_isr);
+		}
+		dev->last = dev->stats;
+		memset(dev->hist,0,sizeof(dev->hist));
+	}
+	self->last_report = now;
+	return 1;
+}
+
+/**
+  * @brief  chiude e rimuove la mappatura di tutti i device, liberando
+  * 		le copie dei registri associate agli indirizzi (gpio_shadow.h)
+  * @param  self: puntatore al runtime
+  * @retval None
+  */
+void UIO_RT_close(uio_rt_t* self){
+	int i;
+
+	for(i = 0; i < self->count; i++){
+		APE_SHADOW_invalidate(self->devices[i].base_addr);
+		munmap(self->devices[i].base_addr,UIO_RT_MAP_SIZE);
+		close(self->devices[i].fd);
+	}
+	self->count = 0;
+	close(self->epfd);
+}
+/**@}*/
+/**@}*/
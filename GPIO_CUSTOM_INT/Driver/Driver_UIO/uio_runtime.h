@@ -0,0 +1,137 @@
+/**
+  ******************************************************************************
+  * @file    uio_runtime.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce il runtime multi-periferica del driver UIO.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup UIO
+  * @{
+  * @brief   Runtime che serve piu' periferiche APE_GPIO, ciascuna esportata
+  * 		 come /dev/uioN, con un solo thread.
+  * @details UIO_RT_open apre e mappa un device file e lo aggiunge all'insieme
+  * 		 epoll del runtime. UIO_RT_run attende su tutti i device con una
+  * 		 sola epoll_wait e, per ogni device pronto:
+  * 		 - legge il contatore di interrupt del kernel;
+  * 		 - legge ISR e azzera i soli bit letti;
+  * 		 - riarma la linea nel kernel con write(), prima delle callback, cosi'
+  * 		   un fronte che arriva durante il dispatch genera subito un evento;
+  * 		 - invoca le callback dei pin pendenti con APE_IT_dispatch.
+  * 		 Le callback sono registrate per pin con UIO_RT_register nella
+  * 		 tabella gpio_it_t del device (gpio_it.c va compilato anche nel
+  * 		 driver UIO). UIO_RT_report stampa, per ogni device, eventi e pin
+  * 		 serviti al secondo e il tempo di gestione medio e massimo, misurato
+  * 		 dal risveglio di epoll_wait alla fine del dispatch.
+  * 		 Con UIO_RT_setPoll il runtime passa alla modalita' ibrida: dopo ogni
+  * 		 evento le linee non vengono riarmate e il thread legge in attesa
+  * 		 attiva ISR di tutti i device mappati, servendo i fronti senza
+  * 		 interrupt ne' chiamate di sistema; quando l'attesa supera il budget
+  * 		 le linee sono riarmate e il thread torna a dormire in epoll_wait.
+  * 		 Il budget si adatta al tempo tra gli eventi: se un evento arriva
+  * 		 dopo il risveglio da epoll_wait entro il budget massimo il budget
+  * 		 raddoppia, se arriva oltre il budget massimo si dimezza (fino ad
+  * 		 annullarsi sotto UIO_RT_POLL_MIN_NS).
+  * 		 Il valore letto dal device file e' il contatore cumulativo delle
+  * 		 interrupt gestite dal kernel: un salto maggiore di uno tra due
+  * 		 letture indica interrupt che il thread non ha visto singolarmente
+  * 		 (contate in missed, con contatore e ISR dell'ultimo salto).
+  * 		 Con uio_pdrv_genirq missed resta sempre a zero: il kernel disabilita
+  * 		 la linea ad ogni interrupt e la gestisce di nuovo solo dopo il
+  * 		 riarmo con write(), quindi il contatore avanza di uno per lettura.
+  * 		 Le interrupt arrivate con la linea disabilitata sono consegnate
+  * 		 al riarmo e i fronti accumulati nel frattempo restano nei bit
+  * 		 di ISR. Il sovraccarico compare quindi in coalesced, che conta i
+  * 		 pin pendenti oltre il primo nella stessa interrupt: cresce quando
+  * 		 il ritmo degli ingressi supera quello del percorso user-space.
+  * 		 Due fronti dello stesso pin tra due letture di ISR restano invece
+  * 		 un solo bit e non sono rilevabili. missed e' significativo solo con
+  * 		 driver UIO che contano le interrupt anche a linea disabilitata.
+  * 		 I tempi di gestione sono raccolti anche in un istogramma con passo
+  * 		 UIO_RT_HIST_STEP_NS, da cui il report ricava p50, p99 e p99.9
+  * 		 dell'intervallo; un percentile che cade nell'ultima classe e'
+  * 		 riportato come limite inferiore (">=102.3" us con i valori
+  * 		 predefiniti), il massimo resta esatto. UIO_RT_realtime prepara il thread per latenze
+  * 		 limitate: blocca la memoria in RAM, pre-alloca lo stack, assegna
+  * 		 SCHED_FIFO, fissa il thread su una CPU (preferibilmente isolata con
+  * 		 isolcpus) e dirige sulla stessa CPU le linee di interrupt dei device,
+  * 		 individuate in /proc/interrupts tramite il nome del device UIO.
+  ******************************************************************************
+  */
+#ifndef SRC_UIO_RUNTIME_H_
+#define SRC_UIO_RUNTIME_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <time.h>
+#include "gpio_it.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define UIO_RT_MAX_DEVICES	8		/*!< numero massimo di device serviti*/
+#define UIO_RT_MAP_SIZE		0x10000	/*!< spazio di indirizzamento di un device*/
+#define UIO_RT_POLL_MIN_NS	10000	/*!< budget di attesa attiva iniziale, sotto questo valore e' annullato*/
+#define UIO_RT_HIST_BUCKETS	1024	/*!< classi dell'istogramma dei tempi di gestione, l'ultima raccoglie i valori fuori scala*/
+#define UIO_RT_HIST_STEP_NS	100		/*!< ampiezza di una classe dell'istogramma*/
+#define UIO_RT_PREFAULT_STACK	(256 * 1024)	/*!< stack pre-allocato in modalita' realtime*/
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief statistiche di un device
+  */
+typedef struct {
+	uint64_t events;	/*!< interrupt servite*/
+	uint64_t pins;		/*!< fronti serviti (bit pendenti di ISR)*/
+	uint64_t polled;	/*!< interrupt servite in attesa attiva, senza risveglio dal kernel*/
+	uint64_t missed;	/*!< interrupt contate dal kernel ma non lette dal thread, sempre 0 con uio_pdrv_genirq*/
+	uint64_t coalesced;	/*!< pin serviti insieme ad altri nella stessa interrupt*/
+	uint64_t total_ns;	/*!< somma dei tempi di gestione*/
+	uint32_t max_ns;	/*!< tempo di gestione massimo*/
+} uio_rt_stats_t;
+
+/**
+  * @brief device UIO servito dal runtime
+  */
+typedef struct {
+	const char* path;		/*!< device file*/
+	int fd;					/*!< descrittore del device file*/
+	uint32_t* base_addr;	/*!< registri mappati*/
+	uint32_t info;			/*!< ultimo contatore di interrupt letto dal kernel*/
+	int synced;				/*!< 1 se info e' stato letto almeno una volta*/
+	uint32_t gap_info;		/*!< contatore letto all'ultimo salto*/
+	uint32_t gap_isr;		/*!< ISR letto all'ultimo salto*/
+	int armed;				/*!< 1 se la linea di interrupt e' abilitata nel kernel*/
+	gpio_it_t table;		/*!< callback dei pin*/
+	uio_rt_stats_t stats;	/*!< statistiche cumulative*/
+	uio_rt_stats_t last;	/*!< statistiche all'ultimo report*/
+	uint32_t hist[UIO_RT_HIST_BUCKETS];	/*!< tempi di gestione dall'ultimo report*/
+} uio_rt_device_t;
+
+/**
+  * @brief runtime
+  */
+typedef struct {
+	int epfd;									/*!< insieme epoll*/
+	int count;									/*!< device aperti*/
+	uio_rt_device_t devices[UIO_RT_MAX_DEVICES];	/*!< device serviti*/
+	struct timespec last_report;				/*!< istante dell'ultimo report*/
+	struct timespec last_event;					/*!< istante dell'ultimo evento*/
+	uint32_t poll_max_ns;						/*!< budget massimo di attesa attiva, 0 se disabilitata*/
+	uint32_t poll_ns;							/*!< budget di attesa attiva corrente*/
+} uio_rt_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+int UIO_RT_Init(uio_rt_t*);
+int UIO_RT_open(uio_rt_t*,const char*);
+void UIO_RT_register(uio_rt_t*,int,int,APE_IT_callback_t,void*);
+void UIO_RT_setPoll(uio_rt_t*,uint32_t);
+int UIO_RT_realtime(uio_rt_t*,int,int);
+int UIO_RT_run(uio_rt_t*,int);
+int UIO_RT_report(uio_rt_t*,int);
+void UIO_RT_close(uio_rt_t*);
+
+#endif /* SRC_UIO_RUNTIME_H_ */
+/**@}*/
+/**@}*/
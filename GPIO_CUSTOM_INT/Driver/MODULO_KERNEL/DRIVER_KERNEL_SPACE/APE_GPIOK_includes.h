@@ -31,10 +31,37 @@
 
 #define APE_INT_MASK		0xFFFFFFFF	/*!< maschera per abilitare tutte le interrupt*/
 
+#define APE_MAX_IRQ_LINES	8	/*!< Numero massimo di linee di interrupt per device*/
+
 /**
   * @brief	Tipo struttura del device
   */
+typedef struct APE_GPIOK_dev APE_GPIOK_dev_t;
+
+/**
+  * @brief	Tipo struttura IER_status_t.
+  * @details Struttura utilizzata per salvare lo stato dei registri IERR e IERF.
+  */
+typedef struct {
+	unsigned int IERR_status;
+	unsigned int IERF_status;
+}IER_status_t;
+
+/**
+  * @brief	Tipo struttura di una linea di interrupt del device.
+  * @details Ogni linea serve un gruppo contiguo di pin della periferica
+  *			(uscita gpio_int_group della APE_GPIO) ed e' registrata
+  *			separatamente presso il kernel, cosi' da poterne impostare
+  *			l'affinita' su una CPU differente.
+  */
 typedef struct {
+	APE_GPIOK_dev_t *devp;			/*!< Device cui appartiene la linea*/
+	int irq_number;					/*!< Numero della linea di interrupt*/
+	unsigned long mask;				/*!< Maschera dei pin serviti dalla linea*/
+	IER_status_t ier_status;		/*!< IERR e IERF salvati dalla ISR mentre il gruppo e' mascherato*/
+}APE_GPIOK_irq_line_t;
+
+struct APE_GPIOK_dev {
 	dev_t dev_num;					/*!< Major/minor number del device*/
 	unsigned int size;				/*!< Dimensione della memoria da associare al device*/
 	struct resource res;			/*!< Struttura della risorsa device rappresentata in memoria, contiene start e end*/
@@ -42,7 +69,8 @@ typedef struct {
 	struct cdev cdev;				/*!< Struttura char device interna al kernel*/
 	unsigned long *base_addr;		/*!< Indirizzo base*/
 
-	int irq_number;					/*!< Numero della linea di interrupt*/
+	APE_GPIOK_irq_line_t irq_lines[APE_MAX_IRQ_LINES];	/*!< Linee di interrupt del device*/
+	int num_irq_lines;				/*!< Numero di linee di interrupt registrate*/
 	struct platform_device *op;		/*!< Puntatore alla struttura platform_device associata al device*/
 
 	wait_queue_head_t read_queue;	/*!< Variabile condition per la read*/
@@ -50,20 +78,13 @@ typedef struct {
 
 	spinlock_t num_interrupts_sl;	/*!< Variabile lock contatore delle interrupt*/
 	spinlock_t read_flag_sl;		/*!< Variabile lock per flag abilitazione lettura*/
+	spinlock_t ier_sl;				/*!< Variabile lock per i registri IERR e IERF e per ier_masked*/
+	unsigned long ier_masked;		/*!< Pin dei gruppi mascherati da una ISR in esecuzione*/
 
 	int num_interrupts;				/*!< Contatore delle interruzioni avvenute*/
 	int read_flag;					/*!< Flag di abilitazione lettura*/
 
-}APE_GPIOK_dev_t;
-
-/**
-  * @brief	Tipo struttura IER_status_t.
-  * @details Struttura utilizzata per salvare lo stato dei registri IERR e IERF.
-  */
-typedef struct {
-	unsigned int IERR_status;
-	unsigned int IERF_status;
-}IER_status_t;
+};
 
 /* Prototipi delle funzioni --------------------------------------------------*/
 extern void APE_GPIOK_setDIR(APE_GPIOK_dev_t*, unsigned long mask);
@@ -71,6 +92,8 @@ extern void APE_GPIOK_writeIER(APE_GPIOK_dev_t*, unsigned long mask);
 extern void APE_GPIOK_clearISR(APE_GPIOK_dev_t*, unsigned long mask);
 extern void APE_GPIOK_saveInt(APE_GPIOK_dev_t*,IER_status_t*);
 extern void APE_GPIOK_restoreInt(APE_GPIOK_dev_t*,IER_status_t*);
+extern void APE_GPIOK_maskInt(APE_GPIOK_dev_t*, unsigned long mask, IER_status_t*);
+extern void APE_GPIOK_unmaskInt(APE_GPIOK_dev_t*, unsigned long mask, IER_status_t*);
 
 #endif /*APE_GPIOK_INCLUDES_H*/
 
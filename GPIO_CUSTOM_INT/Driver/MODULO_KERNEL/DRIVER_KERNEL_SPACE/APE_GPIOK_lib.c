@@ -68,5 +68,35 @@ extern void APE_GPIOK_restoreInt(APE_GPIOK_dev_t* devp,IER_status_t *status){
 	iowrite32(status->IERF_status,devp->base_addr + (APE_IERF_REG/4));
 }
 
+/**
+  * @brief	Salva lo stato dei registri IERR e IERF e disabilita le sole interrupt
+  *			specificate da mask, lasciando inalterate le altre.
+  *	@param	devp puntatore alla struttura del device.
+  *	@param	mask maschera delle interrupt da disabilitare.
+  *	@param	status puntatore alla struttura in cui salvare lo stato dei due registri.
+  *	@retval	None
+  */
+extern void APE_GPIOK_maskInt(APE_GPIOK_dev_t* devp, unsigned long mask, IER_status_t *status){
+	APE_GPIOK_saveInt(devp,status);
+	iowrite32(status->IERR_status & ~mask,devp->base_addr + (APE_IERR_REG/4));
+	iowrite32(status->IERF_status & ~mask,devp->base_addr + (APE_IERF_REG/4));
+}
+
+/**
+  *	@brief	Ripristina, per le sole interrupt specificate da mask, i valori salvati
+  *			con APE_GPIOK_maskInt. I bit esterni a mask mantengono il valore corrente.
+  *	@param	devp puntatore alla struttura del device.
+  *	@param	mask maschera delle interrupt da ripristinare.
+  *	@param	status puntatore alla struttura che mantiene le informazioni sui due registri.
+  *	@retval	None
+  */
+extern void APE_GPIOK_unmaskInt(APE_GPIOK_dev_t* devp, unsigned long mask, IER_status_t *status){
+	unsigned int ierr = ioread32(devp->base_addr + (APE_IERR_REG/4));
+	unsigned int ierf = ioread32(devp->base_addr + (APE_IERF_REG/4));
+
+	iowrite32((ierr & ~mask) | (status->IERR_status & mask),devp->base_addr + (APE_IERR_REG/4));
+	iowrite32((ierf & ~mask) | (status->IERF_status & mask),devp->base_addr + (APE_IERF_REG/4));
+}
+
 /**@}*/
 /**@}*/
@@ -22,6 +22,15 @@
   *			che avviene ogni volta che un device viene caricato. Per le successive chiamata,
   *			la funzione probe di occupa solo di creare una nuova struttura e associarla
   *			all'array.
+  *			Ogni periferica puo' esporre piu' linee di interrupt, una per gruppo di pin
+  *			(uscita gpio_int_group della APE_GPIO). Le linee sono elencate nella proprieta'
+  *			"interrupts" del device tree. L'ampiezza dei gruppi e' ceil(width/int_groups),
+  *			calcolata dai generic della periferica esportati da Vivado ("xlnx,width" e
+  *			"xlnx,int-groups"); se assenti e' letta dalla proprieta' "ape,int-group-width",
+  *			che deve coincidere con il valore sintetizzato (default: un unico gruppo di
+  *			32 pin). Ogni linea e' registrata
+  *			separatamente e la sua affinita' e' distribuita sulle CPU disponibili, in modo
+  *			che i pin critici non restino in coda a quelli piu' rumorosi.
   ******************************************************************************
   */
 
@@ -47,6 +56,8 @@
 #include <linux/spinlock.h>
 #include <linux/interrupt.h>
 #include <linux/device.h>
+#include <linux/of.h>
+#include <linux/cpumask.h>
 
 #include "APE_GPIOK_includes.h"
 
@@ -65,7 +76,8 @@ static int APE_GPIOK_release(struct inode *, struct file *);
 static ssize_t APE_GPIOK_read(struct file *, char *, size_t , loff_t *);
 static ssize_t APE_GPIOK_write(struct file *, const char *, size_t , loff_t *);
 static unsigned int APE_GPIOK_poll(struct file *filp, poll_table *wait);
-static irqreturn_t APE_GPIOK_handler(int irq, struct pt_regs * regs);
+static irqreturn_t APE_GPIOK_handler(int irq, void *dev_id);
+static void APE_GPIOK_freeIrqLines(APE_GPIOK_dev_t *devp);
 
 /**
   * @brief	Stuttura delle operazioni esportate dal modulo.
@@ -209,6 +221,35 @@ ssize_t APE_GPIOK_read(struct file *file, char *buf, size_t count, loff_t *ppos)
 	return 1;
 }
 
+/**
+  *	@brief	Scrive IERR o IERF da user-space in mutua esclusione con le ISR.
+  * @details I bit dei gruppi mascherati da una ISR in esecuzione non sono scritti
+  *			sul registro, ma nello stato salvato della linea, che la ISR ripristina
+  *			al termine: la scrittura non e' annullata dalla riabilitazione del gruppo.
+  * @param	devp: puntatore alla struttura del device.
+  * @param	rising: 1 per IERR, 0 per IERF.
+  * @param	value: valore da scrivere.
+  *	@retval	None
+  */
+static void APE_GPIOK_writeIERLocked(APE_GPIOK_dev_t *devp, int rising, u32 value){
+
+	int i;
+	unsigned long flags;
+	APE_GPIOK_irq_line_t *line;
+	unsigned int *saved;
+
+	spin_lock_irqsave(&devp->ier_sl, flags);
+	for(i = 0; i < devp->num_irq_lines; i++){
+		line = &devp->irq_lines[i];
+		if(line->mask & devp->ier_masked){
+			saved = rising ? &line->ier_status.IERR_status : &line->ier_status.IERF_status;
+			*saved = (*saved & ~line->mask) | (value & line->mask);
+		}
+	}
+	iowrite32(value & ~devp->ier_masked, devp->base_addr + (rising ? APE_IERR_REG/4 : APE_IERF_REG/4));
+	spin_unlock_irqrestore(&devp->ier_sl, flags);
+}
+
 /**
   *	@brief	Trasferisce dati buffer user-space al device.
   * @details Come per la funzione di read, anche la write incremente il valore di ppos,
@@ -237,7 +278,11 @@ ssize_t APE_GPIOK_write(struct file *file, const char *buf, size_t count, loff_t
 	}
 
 	/* Completa la scrittura del dato*/
-	iowrite32(value, write_addr);
+	if(*ppos == APE_IERR_REG/4 || *ppos == APE_IERF_REG/4){
+		APE_GPIOK_writeIERLocked(devp, *ppos == APE_IERR_REG/4, value);
+	} else {
+		iowrite32(value, write_addr);
+	}
 	printk(KERN_INFO "Valore Scritto: %u\n",value);
 
     /* Incrementa la posizione*/
@@ -293,29 +338,25 @@ unsigned int APE_GPIOK_poll(struct file *file, poll_table *wait){
   * @details Si fa notare che la periferica e' progettata in modo tale che, se la direzione
   *			 e' impostata in scrittura sul pad, non vengono mai sollevate eccezioni.
   *			Dunque e' possibile evitare di restituire IRQ_NONE secondo la convenzione.
+  *			La ISR serve una sola linea di interrupt: disabilita, azzera e ripristina
+  *			esclusivamente le interrupt del gruppo di pin associato alla linea, cosi'
+  *			che linee diverse possano essere servite in parallelo su CPU differenti.
   *	@param	irq: interrupt number
-  *	@param	regs: contiene uno snapshot del contesto del processore prima della ISR
+  *	@param	dev_id: puntatore alla struttura APE_GPIOK_irq_line_t della linea
   *	@retval	Valore che indica se c'e' stata effettivamente una interrupt da servire,
   			in caso affermativo deve valere IRQ_HANDLED altrimenti IRQ_NONE
   */
-static irqreturn_t APE_GPIOK_handler(int irq, struct pt_regs * regs){
+static irqreturn_t APE_GPIOK_handler(int irq, void *dev_id){
 
 	unsigned long flags;
-	int i;
-	IER_status_t int_status;
-	APE_GPIOK_dev_t *devp;
-
-	/* identifica il device mediante la linea irq*/
-	for(i = 0; i < num_of_devices; i++){
-		if(device_array[i]->irq_number == irq){
-			devp = device_array[i];
-			break;
-		}
-	}
-
-	/* Disabilita le interruzioni*/
-	APE_GPIOK_saveInt(devp,&int_status);
-	APE_GPIOK_writeIER(devp,0x0);
+	APE_GPIOK_irq_line_t *line = dev_id;
+	APE_GPIOK_dev_t *devp = line->devp;
+
+	/* Disabilita le interruzioni del gruppo*/
+	spin_lock_irqsave(&devp->ier_sl, flags);
+	APE_GPIOK_maskInt(devp,line->mask,&line->ier_status);
+	devp->ier_masked |= line->mask;
+	spin_unlock_irqrestore(&devp->ier_sl, flags);
 	printk(KERN_INFO "ISR in esecuzione\n");
 
 	/* Accesso al flag abilitazione alla lettura ------------------------------*/
@@ -345,15 +386,35 @@ static irqreturn_t APE_GPIOK_handler(int irq, struct pt_regs * regs){
 	wake_up_interruptible(&devp->read_queue);
 	wake_up(&devp->poll_queue);
 
-	/* Riabilita le interrupt*/
-	APE_GPIOK_clearISR(devp,APE_INT_MASK);
-	APE_GPIOK_restoreInt(devp,&int_status);
+	/* Riabilita le interrupt del gruppo*/
+	APE_GPIOK_clearISR(devp,line->mask);
+	spin_lock_irqsave(&devp->ier_sl, flags);
+	devp->ier_masked &= ~line->mask;
+	APE_GPIOK_unmaskInt(devp,line->mask,&line->ier_status);
+	spin_unlock_irqrestore(&devp->ier_sl, flags);
 
 	printk(KERN_INFO "Interrupt Handler completa\n");
 
 	return IRQ_HANDLED;
 }
 
+/**
+  *	@brief	Rilascia tutte le linee di interrupt registrate per un device.
+  *	@param	devp Puntatore alla struttura del device.
+  *	@retval	None
+  */
+static void APE_GPIOK_freeIrqLines(APE_GPIOK_dev_t *devp){
+
+	int i;
+
+	for(i = 0; i < devp->num_irq_lines; i++){
+		irq_set_affinity_hint(devp->irq_lines[i].irq_number, NULL);
+		free_irq(devp->irq_lines[i].irq_number, &devp->irq_lines[i]);
+	}
+	devp->num_irq_lines = 0;
+	devp->ier_masked = 0;
+}
+
 /**
   *	@brief	Callback probe del platform driver, invocata quando il modulo viene inserito.
   *	@param	op Puntatore a struttura platform_device cui l'oggetto APE_GPIOK_dev_t si riferisce.
@@ -364,8 +425,13 @@ static int APE_GPIOK_probe(struct platform_device *op){
 	int i;
 	int status;
 	int irq;
+	int num_lines;
+	u32 group_width;
+	u32 hw_width;
+	u32 hw_groups;
 
 	APE_GPIOK_dev_t *devp;
+	APE_GPIOK_irq_line_t *line;
 	struct device *dev;
 
 	printk(KERN_INFO "APE_GPIOK_probe %d\n", num_of_devices);
@@ -460,18 +526,6 @@ static int APE_GPIOK_probe(struct platform_device *op){
 	}
 	printk(KERN_INFO "Mapping indirizzi virtuali riuscito\n");
 
-	/* Parsing del DTB per ottenere per ottenere il numero della IRQ*/
-	irq = irq_of_parse_and_map(dev->of_node, 0);
-	devp->irq_number=irq;
-
-	/* Registrazione dell'IRQ handler, usa le fast interrupt*/
-	status= request_irq(irq,(irq_handler_t) APE_GPIOK_handler, 0, DRIVER_NAME, NULL);
-	if(status){
-		printk(KERN_ERR "Registrazione linea interrupt fallita %d\n",irq);
-		goto err_req_int;
-	}
-    printk(KERN_INFO "Registrazione linea interrupt riuscita %d\n",irq);
-
 	/* Inizializzazione delle strutture ---------------------------------------*/
 
 	/* Associa la struttura platform device al device che si sta inizializzando*/
@@ -484,9 +538,70 @@ static int APE_GPIOK_probe(struct platform_device *op){
 	/* Spinlocks*/
 	spin_lock_init(&devp->read_flag_sl);
 	spin_lock_init(&devp->num_interrupts_sl);
+	spin_lock_init(&devp->ier_sl);
 
 	devp->read_flag = 0;
 	devp->num_interrupts = 0;
+	devp->num_irq_lines = 0;
+	devp->ier_masked = 0;
+
+	/* Parsing del DTB per ottenere il numero di linee e l'ampiezza dei gruppi*/
+	num_lines = of_irq_count(dev->of_node);
+	if(num_lines <= 0){
+		printk(KERN_ERR "Nessuna linea di interrupt nel DTB\n");
+		status = -EINVAL;
+		goto err_req_int;
+	}
+	if(num_lines > APE_MAX_IRQ_LINES){
+		num_lines = APE_MAX_IRQ_LINES;
+	}
+	/* L'ampiezza dei gruppi e' quella della periferica, ceil(width/int_groups),
+	   ricavata dai generic esportati da Vivado nel DTB; in loro assenza vale
+	   "ape,int-group-width", che deve coincidere con il valore sintetizzato*/
+	if(!of_property_read_u32(dev->of_node, "xlnx,width", &hw_width) &&
+	   !of_property_read_u32(dev->of_node, "xlnx,int-groups", &hw_groups) &&
+	   hw_groups > 0 && hw_groups <= hw_width){
+		group_width = DIV_ROUND_UP(hw_width, hw_groups);
+		if(num_lines != hw_groups){
+			printk(KERN_WARNING "Linee di interrupt nel DTB (%d) diverse da int_groups (%u)\n",num_lines,hw_groups);
+		}
+	} else if(of_property_read_u32(dev->of_node, "ape,int-group-width", &group_width)){
+		group_width = 32;
+	}
+	if(group_width == 0 || group_width > 32){
+		group_width = 32;
+	}
+
+	/* Registrazione di un IRQ handler per ogni linea, usa le fast interrupt*/
+	for(i = 0; i < num_lines; i++){
+		irq = irq_of_parse_and_map(dev->of_node, i);
+
+		line = &devp->irq_lines[i];
+		line->devp = devp;
+		line->irq_number = irq;
+
+		/* La linea i serve i pin da i*group_width in poi, l'ultima anche tutti i pin restanti*/
+		if(i*group_width >= 32){
+			line->mask = 0;
+		} else if(i == num_lines-1 || group_width == 32){
+			line->mask = APE_INT_MASK << (i*group_width);
+		} else {
+			line->mask = ((1UL << group_width) - 1) << (i*group_width);
+		}
+
+		status = request_irq(irq,(irq_handler_t) APE_GPIOK_handler, 0, DRIVER_NAME, line);
+		if(status){
+			printk(KERN_ERR "Registrazione linea interrupt fallita %d\n",irq);
+			APE_GPIOK_freeIrqLines(devp);
+			goto err_req_int;
+		}
+		devp->num_irq_lines = devp->num_irq_lines + 1;
+
+		/* Distribuisce le linee sulle CPU disponibili*/
+		irq_set_affinity_hint(irq, cpumask_of(i % num_online_cpus()));
+
+		printk(KERN_INFO "Registrazione linea interrupt riuscita %d (maschera %08lx)\n",irq,line->mask);
+	}
 
 	/* Aggiunge il device all'array*/
 	device_array[num_of_devices] = devp;
@@ -499,7 +614,6 @@ static int APE_GPIOK_probe(struct platform_device *op){
 	return 0;
 
 	/* Gestione errori --------------------------------------------------------*/
-	    free_irq(irq, NULL);
 	err_req_int:
 	    iounmap(devp->base_addr);
 	err_ioremap:
@@ -539,7 +653,7 @@ static int APE_GPIOK_remove(struct platform_device *op){
 	}
 
 	/* Rilascia le linee di interrupt*/
-	free_irq(devp->irq_number, NULL);
+	APE_GPIOK_freeIrqLines(devp);
 
 	/* Effettua l'unmap dello spazio di memoria I/O*/
 	iounmap(devp->base_addr);
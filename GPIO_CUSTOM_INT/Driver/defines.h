@@ -28,9 +28,17 @@
 /**
   * @brief Seleziona il tipo di driver da implementare
   * @note  <br>/!\ Nel caso UIO è necessario ridefinire runtime il base address dopo la mmap.
+  * @note  <br>/!\ Nel caso SIM gli accessi ai registri sono inoltrati al backend
+  * 		registrato con APE_setBus (vedi gpio_LL.h) e non all'hardware.
+  * @note  Il driver puo' essere scelto anche da riga di comando (es. -DDRIVER_SIM
+  * 		per i test su host in Driver_SIM/test), in tal caso la selezione
+  * 		seguente e' ignorata.
   */
+#if !defined(DRIVER_UIO) && !defined(DRIVER_BARE) && !defined(DRIVER_SIM)
 //#define DRIVER_UIO
 #define DRIVER_BARE
+//#define DRIVER_SIM
+#endif
 
 /*
  * @brief Definisce l'indizzo base della periferica GPIO utilizzata.
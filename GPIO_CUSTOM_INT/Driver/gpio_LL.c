@@ -18,7 +18,79 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <assert.h>
-#include "gpio_LL.h"
+#include <stddef.h>
+#include "gpio_LL_inline.h"
+
+#ifdef DRIVER_SIM
+static APE_bus_t bus;						/*!< backend di bus corrente*/
+static void (*bus_irq_handler)(void*);		/*!< handler della linea gpio_int simulata*/
+static void* bus_irq_arg;					/*!< argomento dell'handler*/
+
+/**
+  * @brief  registra il backend di bus a cui inoltrare gli accessi ai registri
+  * @param 	backend: puntatore alla struttura del backend, viene copiata
+  *	@retval None
+  */
+void APE_setBus(const APE_bus_t* backend){
+	bus = *backend;
+}
+
+/**
+  * @brief  registra la funzione da invocare quando il backend segnala
+  * 		l'asserzione della linea gpio_int
+  * @param 	handler: funzione da invocare
+  * @param 	arg: argomento passato alla funzione
+  *	@retval None
+  */
+void APE_setBusIRQHandler(void (*handler)(void*),void* arg){
+	bus_irq_handler = handler;
+	bus_irq_arg = arg;
+}
+
+/**
+  * @brief  invocata dal backend all'asserzione della linea gpio_int simulata,
+  * 		consegna l'interrupt all'handler registrato
+  *	@retval None
+  */
+void APE_busIRQ(void){
+	if(bus_irq_handler != NULL){
+		bus_irq_handler(bus_irq_arg);
+	}
+}
+
+/**
+  * @brief  lettura di un registro tramite il backend, che deve essere stato
+  * 		registrato con APE_setBus
+  */
+static uint32_t APE_regRead(uint32_t* addr,int offset){
+	assert(bus.read != NULL);
+	return bus.read(bus.ctx,addr,offset);
+}
+
+/**
+  * @brief  scrittura delle byte lane selezionate da strb tramite il backend
+  */
+static void APE_regWrite(uint32_t* addr,int offset,uint32_t value,uint8_t strb){
+	assert(bus.write != NULL);
+	bus.write(bus.ctx,addr,offset,value,strb);
+}
+#else
+/**
+  * @brief  lettura di un registro della periferica
+  */
+static uint32_t APE_regRead(uint32_t* addr,int offset){
+	return APE_read32(addr,offset);
+}
+
+/**
+  * @brief  scrittura di un registro della periferica, strb e' ignorato:
+  * 		l'accesso e' sempre a 32 bit
+  */
+static void APE_regWrite(uint32_t* addr,int offset,uint32_t value,uint8_t strb){
+	(void)strb;
+	APE_write32(addr,offset,value);
+}
+#endif /* DRIVER_SIM */
 
 /**
   * @brief  scrive un valore di 32 bit in un registro
@@ -34,12 +106,13 @@
   *	@retval None
   */
 void APE_writeValue32(uint32_t* addr,int offset,uint32_t value){
-	assert(((uint32_t)addr)%4 == 0);
-	addr[offset/4] = value;
+	assert(((uintptr_t)addr)%4 == 0);
+	APE_regWrite(addr,offset,value,0xF);
 }
 
 /**
-  * @brief  scrive un valore di 16 bit in un registro
+  * @brief  scrive un valore di 16 bit in un registro, le altre
+  * 		parti del registro restano invariate
   * @param 	addr: indirizzo base del registro
   * @param  offset: offset sommato all'indirizzo base.
   *   Questo parametro può assumere i seguenti valori:
@@ -56,13 +129,18 @@ void APE_writeValue32(uint32_t* addr,int offset,uint32_t value){
   *	@retval None
   */
 void APE_writeValue16(uint32_t* addr,int offset,uint16_t value,int part){
-	assert(((uint32_t)addr)%4 == 0);
+	assert(((uintptr_t)addr)%4 == 0);
+#ifdef DRIVER_SIM
 	uint32_t val_32 = (uint32_t)value<<(16*part);
-	addr[offset/4] = val_32;
+	APE_regWrite(addr,offset,val_32,0x3<<(2*part));
+#else
+	APE_write16(addr,offset,value,part);
+#endif
 }
 
 /**
-  * @brief  scrive un valore di 8 bit in un registro
+  * @brief  scrive un valore di 8 bit in un registro, le altre
+  * 		parti del registro restano invariate
   * @param 	addr: indirizzo base del registro
   * @param  offset: offset sommato all'indirizzo base.
   *   Questo parametro può assumere i seguenti valori:
@@ -81,9 +159,13 @@ void APE_writeValue16(uint32_t* addr,int offset,uint16_t value,int part){
   *	@retval None
   */
 void APE_writeValue8(uint32_t* addr,int offset,uint8_t value,int part){
-	assert(((uint32_t)addr)%4 == 0);
+	assert(((uintptr_t)addr)%4 == 0);
+#ifdef DRIVER_SIM
 	uint32_t val_32 = (uint32_t)value<<(8*part);
-	addr[offset/4] = val_32;
+	APE_regWrite(addr,offset,val_32,0x1<<part);
+#else
+	APE_write8(addr,offset,value,part);
+#endif
 }
 
 /**
@@ -99,8 +181,8 @@ void APE_writeValue8(uint32_t* addr,int offset,uint8_t value,int part){
   *	@retval Il valore a 32 bit letto dal registro
   */
 uint32_t APE_readValue32(uint32_t* addr,int offset){
-	assert(((uint32_t)addr)%4 == 0);
-	return addr[offset/4];
+	assert(((uintptr_t)addr)%4 == 0);
+	return APE_regRead(addr,offset);
 }
 
 
@@ -121,8 +203,8 @@ uint32_t APE_readValue32(uint32_t* addr,int offset){
   *	@retval Il valore a 16 bit letto dal registro
   */
 uint16_t APE_readValue16(uint32_t* addr,int offset, int part){
-	assert(((uint32_t)addr)%4 == 0);
-	uint32_t val_32 = addr[offset/4];
+	assert(((uintptr_t)addr)%4 == 0);
+	uint32_t val_32 = APE_regRead(addr,offset);
 	val_32=val_32>>(16*part);
 	return (uint16_t)val_32;
 }
@@ -147,8 +229,8 @@ uint16_t APE_readValue16(uint32_t* addr,int offset, int part){
   *	@retval Il valore a 8 bit letto dal registro
   */
 uint8_t APE_readValue8(uint32_t* addr,int offset, int part){
-	assert(((uint32_t)addr)%4 == 0);
-	uint32_t val_32 = addr[offset/4];
+	assert(((uintptr_t)addr)%4 == 0);
+	uint32_t val_32 = APE_regRead(addr,offset);
 	val_32=val_32>>(8*part);
 	return (uint8_t)val_32;
 }
@@ -170,7 +252,7 @@ uint8_t APE_readValue8(uint32_t* addr,int offset, int part){
   */
 void APE_setBit(uint32_t* addr,int offset,bool val,int pos){
 	uint32_t mask = 0x1 << pos;
-	assert(((uint32_t)addr)%4 == 0);
+	assert(((uintptr_t)addr)%4 == 0);
 
 	if(val){
 		APE_writeValue32(addr,offset,APE_readValue32(addr,offset) | mask);
@@ -194,7 +276,7 @@ void APE_setBit(uint32_t* addr,int offset,bool val,int pos){
   */
 void APE_toggleBit(uint32_t* addr,int offset,int pos){
 	uint32_t mask = 0x1 << pos;
-	assert(((uint32_t)addr)%4 == 0);
+	assert(((uintptr_t)addr)%4 == 0);
 
 	APE_writeValue32(addr,offset,APE_readValue32(addr,offset) ^ mask);
 }
@@ -20,6 +20,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <inttypes.h>
+#include "defines.h"
 
 /* Macro ---------------------------------------------------------------------*/
 #define APE_DATA_REG		0	/*!< offset registro dato*/
@@ -81,6 +82,26 @@ uint8_t APE_readValue8(uint32_t*,int,int);
 void APE_setBit(uint32_t*,int,bool,int);
 void APE_toggleBit(uint32_t*,int,int);
 
+#ifdef DRIVER_SIM
+/**
+  * @brief backend di bus del driver SIM.
+  * @details Ogni accesso ai registri effettuato dalle funzioni di questo modulo
+  *			 viene inoltrato al backend, che lo traduce in una transazione verso
+  *			 un modello della periferica (simulazione RTL, emulatore, ...).
+  *			 Il parametro strb della write segue la semantica di S_AXI_WSTRB:
+  *			 un bit per ogni byte lane del registro da aggiornare.
+  */
+typedef struct {
+	uint32_t (*read)(void* ctx,uint32_t* addr,int offset);				/*!< lettura di un registro*/
+	void (*write)(void* ctx,uint32_t* addr,int offset,uint32_t value,uint8_t strb);	/*!< scrittura di un registro*/
+	void* ctx;															/*!< contesto del backend*/
+} APE_bus_t;
+
+void APE_setBus(const APE_bus_t*);
+void APE_setBusIRQHandler(void (*)(void*),void*);
+void APE_busIRQ(void);
+#endif /* DRIVER_SIM */
+
 #endif /* SRC_GPGPIO_LL_H_ */
 /**@}*/
 /**@}*/
\ No newline at end of file
@@ -0,0 +1,179 @@
+/**
+  ******************************************************************************
+  * @file    gpio_LL_inline.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce gli accessori inline ai registri della
+  * 		 periferica APE_GPIO.
+  *
+  *	@addtogroup LOW_LEVEL
+  * @{
+  * @addtogroup GPIO_LL
+  * @{
+  * @brief   Accessori header-only ai registri: ogni accesso e' una singola
+  * 		 load/store volatile, senza chiamata a funzione, quindi il compilatore
+  * 		 non puo' fondere o eliminare accessi MMIO.
+  * 		 Le macro in maiuscolo verificano a tempo di compilazione che l'offset
+  * 		 sia quello di un registro della periferica; l'offset deve quindi essere
+  * 		 una costante (APE_DATA_REG, APE_DIR_REG, ...).
+  * 		 Definendo APE_LL_BARRIERS ogni accesso e' ordinato rispetto agli
+  * 		 accessi in memoria normale mediante una barriera esplicita (dsb su ARM).
+  * 		 Nel driver SIM gli accessori si appoggiano alle funzioni di GPIO_LL,
+  * 		 che inoltrano l'accesso al backend registrato.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_LL_INLINE_H_
+#define SRC_GPIO_LL_INLINE_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio_LL.h"
+
+/* Macro ---------------------------------------------------------------------*/
+
+/**
+  * @brief barriera di memoria attorno agli accessi ai registri
+  */
+#ifdef APE_LL_BARRIERS
+	#if defined(__arm__)
+		#define APE_BARRIER()	__asm__ __volatile__("dsb" ::: "memory")		/*!< barriera ARMv7*/
+	#elif defined(__aarch64__)
+		#define APE_BARRIER()	__asm__ __volatile__("dsb sy" ::: "memory")	/*!< barriera ARMv8*/
+	#else
+		#define APE_BARRIER()	__sync_synchronize()						/*!< barriera generica*/
+	#endif
+#else
+	#define APE_BARRIER()	((void)0)	/*!< nessuna barriera*/
+#endif /* APE_LL_BARRIERS */
+
+/**
+  * @brief verifica a tempo di compilazione una condizione costante, se falsa
+  * 		la compilazione fallisce (larghezza negativa del campo di bit)
+  */
+#define APE_STATIC_CHECK(cond)	((void)sizeof(struct { int ape_verifica_fallita : ((cond) ? 1 : -1); }))
+
+/**
+  * @brief verifica a tempo di compilazione che offset sia l'offset di un
+  * 		registro della periferica
+  */
+#define APE_REG_CHECK(offset)	APE_STATIC_CHECK((offset) % 4 == 0 && (offset) >= APE_DATA_REG && (offset) <= APE_ICRISR_REG)
+
+/**
+  * @brief accessori con verifica dell'offset a tempo di compilazione
+  */
+#define APE_READ32(addr,offset)			(APE_REG_CHECK(offset), APE_read32((addr),(offset)))			/*!< lettura a 32 bit*/
+#define APE_WRITE32(addr,offset,value)	(APE_REG_CHECK(offset), APE_write32((addr),(offset),(value)))	/*!< scrittura a 32 bit*/
+#define APE_SET32(addr,offset,mask)		(APE_REG_CHECK(offset), APE_setMask32((addr),(offset),(mask)))	/*!< imposta a '1' i bit di mask*/
+#define APE_CLEAR32(addr,offset,mask)	(APE_REG_CHECK(offset), APE_clearMask32((addr),(offset),(mask)))	/*!< imposta a '0' i bit di mask*/
+#define APE_TOGGLE32(addr,offset,mask)	(APE_REG_CHECK(offset), APE_toggleMask32((addr),(offset),(mask)))	/*!< inverte i bit di mask*/
+#define APE_WRITE16(addr,offset,value,part)	(APE_REG_CHECK(offset), APE_write16((addr),(offset),(value),(part)))	/*!< scrittura della sola half-word part*/
+#define APE_WRITE8(addr,offset,value,part)	(APE_REG_CHECK(offset), APE_write8((addr),(offset),(value),(part)))		/*!< scrittura del solo byte part*/
+
+/* Funzioni inline -----------------------------------------------------------*/
+
+/**
+  * @brief  legge un registro a 32 bit
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  *	@retval il valore letto
+  */
+static inline uint32_t APE_read32(uint32_t* addr,int offset){
+#ifdef DRIVER_SIM
+	return APE_readValue32(addr,offset);
+#else
+	uint32_t value = ((volatile uint32_t*)addr)[offset/4];
+	APE_BARRIER();
+	return value;
+#endif
+}
+
+/**
+  * @brief  scrive un registro a 32 bit
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * @param 	value: valore da scrivere
+  *	@retval None
+  */
+static inline void APE_write32(uint32_t* addr,int offset,uint32_t value){
+#ifdef DRIVER_SIM
+	APE_writeValue32(addr,offset,value);
+#else
+	APE_BARRIER();
+	((volatile uint32_t*)addr)[offset/4] = value;
+#endif
+}
+
+/**
+  * @brief  scrive una half-word di un registro con una store a 16 bit:
+  * 		sul bus AXI sono attive le sole byte lane (WSTRB) della half-word,
+  * 		le altre parti del registro restano invariate
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * @param 	value: valore da scrivere
+  * @param  part: half-word selezionata (L, H)
+  *	@retval None
+  */
+static inline void APE_write16(uint32_t* addr,int offset,uint16_t value,int part){
+#ifdef DRIVER_SIM
+	APE_writeValue16(addr,offset,value,part);
+#else
+	APE_BARRIER();
+	((volatile uint16_t*)addr)[offset/2 + part] = value;
+#endif
+}
+
+/**
+  * @brief  scrive un byte di un registro con una store a 8 bit:
+  * 		sul bus AXI e' attiva la sola byte lane (WSTRB) selezionata,
+  * 		le altre parti del registro restano invariate
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * @param 	value: valore da scrivere
+  * @param  part: byte selezionato (LL, LH, HL, HH)
+  *	@retval None
+  */
+static inline void APE_write8(uint32_t* addr,int offset,uint8_t value,int part){
+#ifdef DRIVER_SIM
+	APE_writeValue8(addr,offset,value,part);
+#else
+	APE_BARRIER();
+	((volatile uint8_t*)addr)[offset + part] = value;
+#endif
+}
+
+/**
+  * @brief  imposta a '1' i bit di una maschera (read-modify-write)
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * @param 	mask: maschera dei bit
+  *	@retval None
+  */
+static inline void APE_setMask32(uint32_t* addr,int offset,uint32_t mask){
+	APE_write32(addr,offset,APE_read32(addr,offset) | mask);
+}
+
+/**
+  * @brief  imposta a '0' i bit di una maschera (read-modify-write)
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * @param 	mask: maschera dei bit
+  *	@retval None
+  */
+static inline void APE_clearMask32(uint32_t* addr,int offset,uint32_t mask){
+	APE_write32(addr,offset,APE_read32(addr,offset) & ~mask);
+}
+
+/**
+  * @brief  inverte i bit di una maschera (read-modify-write)
+  * @param 	addr: indirizzo base della periferica
+  * @param  offset: offset del registro
+  * @param 	mask: maschera dei bit
+  *	@retval None
+  */
+static inline void APE_toggleMask32(uint32_t* addr,int offset,uint32_t mask){
+	APE_write32(addr,offset,APE_read32(addr,offset) ^ mask);
+}
+
+#endif /* SRC_GPIO_LL_INLINE_H_ */
+/**@}*/
+/**@}*/
@@ -15,9 +15,13 @@
   *			 mediante la syscall mmap, si hanno 3 modalità di esecuzione:
   * 		 - IN: generica lettura dei registri della periferica.
   * 		 - OUT: generica scrittura verso i registri della periferica.
-  * 		 - TEST: il driver fa uso delle librerie LIB_OBJECTS e cicla sul valore
-  *					del registro dato. Sul nibble dedicato ai led viene assegnato il
-  *					il valore letto dai bottoni in AND con quello degli switch.
+  * 		 - TEST: il driver fa uso delle librerie LIB_OBJECTS e campiona il
+  *					registro dato ogni POLL_PERIOD_US (o il periodo indicato con -p)
+  *					mediante il motore di gpio_poll.h. Solo quando bottoni o switch
+  *					cambiano, sul nibble dedicato ai led viene assegnato il valore
+  *					letto dai bottoni in AND con quello degli switch. Ogni
+  *					REPORT_INTERVAL_MS sono stampate frequenza di campionamento
+  *					ottenuta e utilizzo della CPU.
   *
   * Il driver fa uso delle librerie LIB_OBJECTS e delle LOW_LEVEL, il modulo define
   *	e' configurato nella stessa modalita' per il driver UIO, pertanto e' necessario
@@ -44,6 +48,11 @@
 #include "button.h"
 #include "led.h"
 #include "switch.h"
+#include "gpio_poll.h"
+
+/* Macro ---------------------------------------------------------------------*/
+#define POLL_PERIOD_US 1000		/*!< periodo di campionamento di default della modalita' TEST */
+#define REPORT_INTERVAL_MS 1000	/*!< intervallo tra i report della modalita' TEST */
 
 /* Typedef -------------------------------------------------------------------*/
 typedef enum {
@@ -55,6 +64,12 @@ typedef enum {
 /* Private function prototypes -----------------------------------------------*/
 void usage(void);
 void initScreen(void);
+void onChange(void* context,const gpio_snapshot_t* snap,uint32_t changed);
+
+/* Private variables ---------------------------------------------------------*/
+static btn_t btn_handler;	/*!< Handler dei bottoni*/
+static switch_t sw_handler;	/*!< Handler degli switch*/
+static led_t led_handler;	/*!< Handler dei led*/
 
 int main(int argc, char *argv[]){
 	int c;
@@ -62,6 +77,7 @@ int main(int argc, char *argv[]){
 	int direction=TEST;
 	unsigned gpio_addr;
 	uint32_t value = 0;
+	uint32_t period_us = POLL_PERIOD_US;
 
 	unsigned page_addr, page_offset;
 	void *ptr;
@@ -69,7 +85,7 @@ int main(int argc, char *argv[]){
 
 	initScreen();
 
-	while((c = getopt(argc, argv, "a:io:h")) != -1) {
+	while((c = getopt(argc, argv, "a:io:p:h")) != -1) {
 		switch(c) {
 		case 'a':
 			gpio_addr=strtoul(optarg,NULL, 0);
@@ -81,6 +97,9 @@ int main(int argc, char *argv[]){
 			direction=OUT;
 			value=strtoul(optarg, NULL, 0);
 			break;
+		case 'p':
+			period_us=strtoul(optarg, NULL, 0);
+			break;
 		case 'h':
 			usage();
 			return 0;
@@ -88,7 +107,7 @@ int main(int argc, char *argv[]){
 			printf("Errore: %c\n", (char)c);
 			usage();
 			return -1;
-
+		}
 	}
 
 	/* Invoca la open sul mem file */
@@ -134,12 +153,8 @@ int main(int argc, char *argv[]){
 	if(direction == TEST) {
 		printf("\n\n Modalità TEST \n\n");
 
-		/*Dichiarazione degli handler e variabili di stato*/
-		btn_t btn_handler;
-		switch_t sw_handler;
-		led_t led_handler;
-		uint32_t sw_status = 0x0;
-		uint32_t btn_status = 0x0;
+		/*Motore di campionamento*/
+		gpio_poll_t poll;
 
 		/*Inizializzazione degli handler*/
 		BTN_Init(&btn_handler);
@@ -160,12 +175,13 @@ int main(int argc, char *argv[]){
 		led_handler.setLeds(&led_handler,LED_ALL_MASK);
 		APE_writeValue32(ptr,APE_DATA_REG,0x0);
 
-		for(;;){
+		/*Campiona bottoni e switch, i led sono aggiornati solo alle variazioni*/
+		POLL_Init(&poll,ptr,BTN_ALL_MASK|SW_ALL_MASK,period_us,&onChange,NULL);
+		onChange(NULL,&poll.snap,BTN_ALL_MASK|SW_ALL_MASK);
 
-			/*Scrive sui led il valore degli switch in and con quello dei bottoni*/
-			sw_status = sw_handler.readStatus(&sw_handler);
-			btn_status = btn_handler.readStatus(&btn_handler);
-			led_handler.setLeds(&led_handler,sw_status & btn_status);
+		for(;;){
+			POLL_step(&poll);
+			POLL_report(&poll,REPORT_INTERVAL_MS);
 		}
 	}
 
@@ -181,13 +197,29 @@ int main(int argc, char *argv[]){
   * @retval None
   */
 void usage(){
-	printf("\n\n *argv[0] -a <INDIRIZZO> -i|-o <VALUE>\n");
+	printf("\n\n *argv[0] -a <INDIRIZZO> -i|-o <VALUE>|-p <US>\n");
 	printf("	-a				Indirizzo base periferica. e.g. 0x43C00000\n");
 	printf("	-i				Lettura dalla GPIO\n");
 	printf("	-o <VALUE>		Scrittura verso la GPIO\n");
+	printf("	-p <US>			TEST: periodo di campionamento in us\n");
 	return;
 }
 
+/**
+  * @brief  invocata dal motore di campionamento quando bottoni o switch
+  *			cambiano: scrive sui led il valore degli switch in AND con quello
+  *			dei bottoni.
+  * @param  context: non utilizzato
+  * @param  snap: fotografia con il nuovo valore del registro dato
+  * @param  changed: bit cambiati
+  * @retval None
+  */
+void onChange(void* context,const gpio_snapshot_t* snap,uint32_t changed){
+	(void)context;
+	(void)changed;
+	led_handler.setLeds(&led_handler,sw_handler.decodeStatus(&sw_handler,snap) & btn_handler.decodeStatus(&btn_handler,snap));
+}
+
 /**
   * @brief  stampa la schermata di presentazione
   * @param  None
@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file    gpio_poll.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file implementa il motore di campionamento periodico del
+  * 		 driver NO_DRIVER.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup NO_DRIVER
+  * @{
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <errno.h>
+#include "gpio_poll.h"
+#include "gpio_LL_inline.h"
+
+/**
+  * @brief  converte un istante in nanosecondi
+  * @param  t: istante
+  * @retval nanosecondi
+  */
+static int64_t POLL_ns(const struct timespec* t){
+	return (int64_t)t->tv_sec * 1000000000LL + t->tv_nsec;
+}
+
+/**
+  * @brief  aggiorna tempo reale e tempo di CPU del thread
+  * @param  self: puntatore al motore
+  * @retval None
+  */
+static void POLL_clocks(gpio_poll_t* self){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	self->stats.wall_ns = POLL_ns(&t);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID,&t);
+	self->stats.cpu_ns = POLL_ns(&t);
+}
+
+/**
+  * @brief  inizializza il motore e legge il valore iniziale, senza invocare
+  * 		la callback
+  * @param  self: puntatore al motore
+  * @param  base_addr: registri mappati della periferica
+  * @param  mask: bit di DATA osservati
+  * @param  period_us: periodo di campionamento in us, almeno 1
+  * @param  callback: funzione invocata alle variazioni
+  * @param  context: argomento passato alla funzione
+  * @retval None
+  */
+void POLL_Init(gpio_poll_t* self,uint32_t* base_addr,uint32_t mask,uint32_t period_us,poll_callback_t callback,void* context){
+	APE_SNAP_Init(&self->snap,base_addr);
+	self->snap.data = APE_READ32(base_addr,APE_DATA_REG);
+	self->mask = mask;
+	self->period_ns = (int64_t)((period_us > 0) ? period_us : 1) * 1000;
+	self->callback = callback;
+	self->context = context;
+	self->stats = (poll_stats_t){ 0 };
+	POLL_clocks(self);
+	self->last = self->stats;
+	clock_gettime(CLOCK_MONOTONIC,&self->next);
+}
+
+/**
+  * @brief  attende la scadenza successiva, campiona DATA e invoca la
+  * 		callback se i bit osservati sono cambiati
+  * @param  self: puntatore al motore
+  * @retval 1 se c'e' stata una variazione, 0 altrimenti
+  */
+int POLL_step(gpio_poll_t* self){
+	struct timespec now;
+	int64_t late;
+	uint32_t data;
+	uint32_t changed;
+
+	/* Scadenza assoluta: il ritardo di un campione non sposta i successivi */
+	self->next.tv_nsec += self->period_ns;
+	while(self->next.tv_nsec >= 1000000000L){
+		self->next.tv_nsec -= 1000000000L;
+		self->next.tv_sec++;
+	}
+	while(clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&self->next,NULL) == EINTR);
+
+	data = APE_READ32(self->snap.base_addr,APE_DATA_REG);
+	self->stats.samples++;
+
+	/* Salta i periodi gia' trascorsi mantenendo la fase */
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	late = POLL_ns(&now) - POLL_ns(&self->next);
+	if(late >= self->period_ns){
+		int64_t skip = late / self->period_ns;
+		int64_t ns = self->next.tv_nsec + skip * self->period_ns;
+
+		self->stats.overruns += skip;
+		self->next.tv_sec += ns / 1000000000L;
+		self->next.tv_nsec = ns % 1000000000L;
+	}
+
+	changed = (data ^ self->snap.data) & self->mask;
+	self->snap.data = data;
+	if(changed == 0){
+		return 0;
+	}
+	self->stats.changes++;
+	self->callback(self->context,&self->snap,changed);
+	return 1;
+}
+
+/**
+  * @brief  stampa le statistiche dall'ultimo report, se e' trascorso almeno
+  * 		l'intervallo indicato
+  * @param  self: puntatore al motore
+  * @param  interval_ms: intervallo minimo tra due report
+  * @retval 1 se il report e' stato stampato, 0 altrimenti
+  */
+int POLL_report(gpio_poll_t* self,int interval_ms){
+	double seconds;
+
+	POLL_clocks(self);
+	seconds = (self->stats.wall_ns - self->last.wall_ns) / 1e9;
+	if(seconds * 1000 < interval_ms){
+		return 0;
+	}
+
+	printf("campioni %.0f/s (richiesti %.0f/s) variazioni %.0f/s periodi saltati %llu CPU %.1f%%\n",
+			(self->stats.samples - self->last.samples) / seconds,
+			1e9 / self->period_ns,
+			(self->stats.changes - self->last.changes) / seconds,
+			(unsigned long long)(self->stats.overruns - self->last.overruns),
+			100.0 * (self->stats.cpu_ns - self->last.cpu_ns) / (self->stats.wall_ns - self->last.wall_ns));
+	self->last = self->stats;
+	return 1;
+}
+/**@}*/
+/**@}*/
@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file    gpio_poll.h
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Questo file definisce il motore di campionamento periodico del
+  * 		 driver NO_DRIVER.
+  *
+  *	@addtogroup DRIVER
+  * @{
+  * @addtogroup NO_DRIVER
+  * @{
+  * @brief   Campionamento periodico del registro dato con rilevazione delle
+  * 		 variazioni, per periferiche senza linea di interrupt.
+  * @details POLL_step dorme con clock_nanosleep fino alla scadenza assoluta
+  * 		 successiva (le scadenze non accumulano deriva), legge una sola volta
+  * 		 il registro DATA e invoca la callback solo se i bit osservati sono
+  * 		 cambiati. Se una scadenza e' gia' trascorsa i periodi persi sono
+  * 		 saltati e contati in overruns, mantenendo la fase. POLL_report
+  * 		 stampa frequenza di campionamento ottenuta, variazioni al secondo e
+  * 		 utilizzo della CPU del thread nell'intervallo.
+  ******************************************************************************
+  */
+#ifndef SRC_GPIO_POLL_H_
+#define SRC_GPIO_POLL_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <time.h>
+#include "gpio_snapshot.h"
+
+/* Typedef -------------------------------------------------------------------*/
+
+/**
+  * @brief callback invocata a ogni variazione: riceve la fotografia con il
+  * 		nuovo valore di DATA (isr non e' letto) e i bit cambiati
+  */
+typedef void (*poll_callback_t)(void* context,const gpio_snapshot_t* snap,uint32_t changed);
+
+/**
+  * @brief contatori del campionamento
+  */
+typedef struct {
+	uint64_t samples;	/*!< letture del registro DATA*/
+	uint64_t changes;	/*!< campioni con variazioni*/
+	uint64_t overruns;	/*!< periodi saltati per scadenze gia' trascorse*/
+	int64_t cpu_ns;		/*!< tempo di CPU del thread*/
+	int64_t wall_ns;	/*!< tempo reale*/
+} poll_stats_t;
+
+/**
+  * @brief motore di campionamento
+  */
+typedef struct {
+	gpio_snapshot_t snap;		/*!< ultimo valore letto*/
+	uint32_t mask;				/*!< bit di DATA osservati*/
+	int64_t period_ns;			/*!< periodo di campionamento*/
+	struct timespec next;		/*!< scadenza del prossimo campione*/
+	poll_callback_t callback;	/*!< funzione invocata alle variazioni*/
+	void* context;				/*!< argomento passato alla funzione*/
+	poll_stats_t stats;			/*!< contatori cumulativi*/
+	poll_stats_t last;			/*!< contatori all'ultimo report*/
+} gpio_poll_t;
+
+/* Prototipi delle funzioni --------------------------------------------------*/
+void POLL_Init(gpio_poll_t*,uint32_t*,uint32_t,uint32_t,poll_callback_t,void*);
+int POLL_step(gpio_poll_t*);
+int POLL_report(gpio_poll_t*,int);
+
+#endif /* SRC_GPIO_POLL_H_ */
+/**@}*/
+/**@}*/
@@ -56,6 +56,16 @@
 --!		  <br>Si ottiene: 		ISR:"0x00000E00"
 --!
 --!	La logica di gestione dei registri ICR e ISR e' implementata dal process <b>ICRISR_management</b>.
+--!
+--! <h3><b>LINEE DI INTERRUPT:</b></h3>
+--!	Oltre a <b>gpio_int</b>, OR di tutti i bit di ISR, la periferica espone <b>gpio_int_group</b>:
+--!	un'uscita di interrupt per ciascuno degli <b>int_groups</b> gruppi contigui di pin
+--!	(1 <= int_groups <= width).
+--!	Il gruppo g comprende i pin da g*G a (g+1)*G-1, con G = ceil(width/int_groups), e la sua
+--!	linea e' la OR dei soli bit di ISR del gruppo. Collegando ogni linea ad una diversa sorgente
+--!	del GIC e' possibile servire i gruppi su CPU differenti: la vista pending di un gruppo e'
+--!	ISR in AND con la maschera del gruppo, la vista di mascheramento sono i bit di IERR/IERF
+--!	del gruppo.
 ----------------------------------------------------------------------------------
 
 library ieee;
@@ -69,6 +79,7 @@ entity APE_GPIO_AXI is
 	generic (
 		-- Users to add parameters here
         width : natural := 4;
+        int_groups : positive := 1;
 		-- User parameters ends
 		-- Do not modify the parameters beyond this line
 
@@ -81,6 +92,7 @@ entity APE_GPIO_AXI is
 		-- Users to add ports here
         pad : inout STD_LOGIC_VECTOR (width-1 downto 0);
         gpio_int : out std_logic;
+        gpio_int_group : out std_logic_vector(int_groups-1 downto 0);
 		-- User ports ends
 		-- Do not modify the ports beyond this line
 
@@ -220,7 +232,27 @@ architecture arch_imp of APE_GPIO_AXI is
 	--! Segnale che proviene dall'output s_out dell'edge_detector.
 	signal edge_detected    :std_logic_vector(C_S_AXI_DATA_WIDTH-1 downto 0) := (others => '0');
 
+	--! Numero di pin per ciascun gruppo di interrupt.
+	constant INT_GROUP_WIDTH : natural := (width + int_groups - 1) / int_groups;
+
+	--! Restituisce la OR dei bit di ISR appartenenti al gruppo g.
+	function group_or(isr : std_logic_vector; g : natural) return std_logic is
+	    variable r : std_logic := '0';
+	begin
+	    for k in 0 to width-1 loop
+	        if (k / INT_GROUP_WIDTH) = g then
+	            r := r or isr(k);
+	        end if;
+	    end loop;
+	    return r;
+	end function;
+
 begin
+	--! Ogni gruppo deve contenere almeno un pin: int_groups e' compreso tra 1 e width.
+	assert int_groups <= width
+	    report "APE_GPIO: int_groups deve essere compreso tra 1 e width"
+	    severity failure;
+
 	-- I/O Connections assignments
 
 	S_AXI_AWREADY	<= axi_awready;
@@ -507,6 +539,12 @@ begin
     -- Il segnale gpio_int è ottenuto mediante la OR di tutti i bit del registro ISR (periph_isr).
     gpio_int <= or_reduce(periph_isr);
 
+    --! @brief Linee di interrupt per gruppo.
+    --! @details Il segnale gpio_int_group(g) e' la OR dei soli bit di ISR del gruppo g.
+    gpio_int_group_gen : for g in 0 to int_groups-1 generate
+        gpio_int_group(g) <= group_or(periph_isr, g);
+    end generate;
+
     -- edge_and_dir abilita a leggere o meno il fronte in base al registro DIR (slv_reg1).
     -- Il segnale edge_detected proviene dall'output dell'edge_detector.
     edge_and_dir <= edge_detected and slv_reg1;
@@ -22,6 +22,7 @@ entity APE_GPIO_TOP is
 	generic (
 		-- Users to add parameters here
         width : natural := 4;
+        int_groups : positive := 1;
 		-- User parameters ends
 		-- Do not modify the parameters beyond this line
 
@@ -34,6 +35,7 @@ entity APE_GPIO_TOP is
 		-- Users to add ports here
         pad : inout STD_LOGIC_VECTOR (width-1 downto 0);
         gpio_int : out std_logic;
+        gpio_int_group : out std_logic_vector(int_groups-1 downto 0);
 		-- User ports ends
 		-- Do not modify the ports beyond this line
 
@@ -69,12 +71,14 @@ architecture arch_imp of APE_GPIO_TOP is
 	component APE_GPIO_AXI is
 		generic (
 		width : natural := 4;
+		int_groups : positive := 1;
 		C_S_AXI_DATA_WIDTH	: integer	:= 32;
 		C_S_AXI_ADDR_WIDTH	: integer	:= 5
 		);
 		port (
 		pad : inout STD_LOGIC_VECTOR (width-1 downto 0);
         gpio_int : out std_logic;
+        gpio_int_group : out std_logic_vector(int_groups-1 downto 0);
 		S_AXI_ACLK	: in std_logic;
 		S_AXI_ARESETN	: in std_logic;
 		S_AXI_AWADDR	: in std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0);
@@ -105,12 +109,14 @@ begin
 APE_GPIO_AXI_inst : APE_GPIO_AXI
 	generic map (
 	    width => width,
+	    int_groups => int_groups,
 		C_S_AXI_DATA_WIDTH	=> C_S00_AXI_DATA_WIDTH,
 		C_S_AXI_ADDR_WIDTH	=> C_S00_AXI_ADDR_WIDTH
 	)
 	port map (
 	    pad => pad,
 	    gpio_int => gpio_int,
+	    gpio_int_group => gpio_int_group,
 		S_AXI_ACLK	=> s00_axi_aclk,
 		S_AXI_ARESETN	=> s00_axi_aresetn,
 		S_AXI_AWADDR	=> s00_axi_awaddr,
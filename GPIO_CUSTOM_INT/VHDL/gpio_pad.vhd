@@ -23,6 +23,7 @@ use IEEE.STD_LOGIC_1164.ALL;
 
 --! Entity gpio_pad
 entity gpio_pad is
+    generic (width : natural := 4);--! Non usato, corrisponde alla dichiarazione del componente in gpio_array (binding di default).
     Port ( write : in STD_LOGIC;--! Porto di scrittura dal PS verso l'esterno.
            dir : in STD_LOGIC;--! Porto di selezione della direzione.
            read : out STD_LOGIC; --!Porto di lettura dall'esterno verso al PS.
@@ -0,0 +1,245 @@
+----------------------------------------------------------------------------------
+--! @file   APE_GPIO_cosim.vhd
+--  Company: Gruppo 5
+--! @author Alfonso, Pierluigi, Erasmo (APE)
+--!
+--! @date 19.10.2026
+--!
+--! @addtogroup APE_GPIO
+--! @{
+--! @addtogroup APE_GPIO_TB
+--! @{
+--!
+--! @brief Testbench di co-simulazione della periferica APE_GPIO_TOP con il
+--! driver SIM.
+--!
+--! @details
+--!	Il testbench non ha una sequenza propria: esegue le richieste del driver
+--!	ricevute tramite APE_GPIO_cosim_pkg. Le letture e scritture dei registri
+--!	sono transazioni del modello funzionale AXI4-Lite (lo stesso di
+--!	APE_GPIO_tb), le richieste sui pad pilotano i pin in ingresso e attendono
+--!	PAD_CYCLES cicli, sufficienti a registrare il fronte in ISR.
+--!	Ogni risposta riporta i cicli di clock consumati e il livello di gpio_int.
+--!	La periferica e' istanziata con la mappatura di defines.h: width = 12,
+--!	un gruppo di interrupt per nibble (SW, LED, BTN). I pad non pilotati sono
+--!	a '0' debole, cosi' i pin in uscita non vanno in conflitto.
+--!	Lo script build_cosim.sh elabora il testbench con la libreria VHPIDIRECT;
+--!	l'eseguibile viene avviato dal driver (Driver_SIM/gpio_cosim.c).
+----------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+use work.APE_GPIO_cosim_pkg.all;
+
+entity APE_GPIO_cosim is
+end APE_GPIO_cosim;
+
+architecture sim of APE_GPIO_cosim is
+
+	constant WIDTH      : natural := 12;
+	constant GROUPS     : positive := 3;
+	constant CLK_PERIOD : time := 10 ns;
+	constant PAD_CYCLES : natural := 4;
+
+	signal clk     : std_logic := '0';
+	signal aresetn : std_logic := '0';
+	signal done    : boolean := false;
+
+	signal awaddr  : std_logic_vector(4 downto 0) := (others => '0');
+	signal awvalid : std_logic := '0';
+	signal awready : std_logic;
+	signal wdata   : std_logic_vector(31 downto 0) := (others => '0');
+	signal wstrb   : std_logic_vector(3 downto 0) := (others => '0');
+	signal wvalid  : std_logic := '0';
+	signal wready  : std_logic;
+	signal bresp   : std_logic_vector(1 downto 0);
+	signal bvalid  : std_logic;
+	signal bready  : std_logic := '0';
+	signal araddr  : std_logic_vector(4 downto 0) := (others => '0');
+	signal arvalid : std_logic := '0';
+	signal arready : std_logic;
+	signal rdata   : std_logic_vector(31 downto 0);
+	signal rresp   : std_logic_vector(1 downto 0);
+	signal rvalid  : std_logic;
+	signal rready  : std_logic := '0';
+
+	signal pad            : std_logic_vector(WIDTH-1 downto 0);
+	signal pad_drv        : std_logic_vector(WIDTH-1 downto 0) := (others => 'L');
+	signal gpio_int       : std_logic;
+	signal gpio_int_group : std_logic_vector(GROUPS-1 downto 0);
+
+begin
+
+	clk <= not clk after CLK_PERIOD/2 when not done else '0';
+
+	pad <= pad_drv;
+
+	dut : entity work.APE_GPIO_TOP
+		generic map (
+			width      => WIDTH,
+			int_groups => GROUPS
+		)
+		port map (
+			pad             => pad,
+			gpio_int        => gpio_int,
+			gpio_int_group  => gpio_int_group,
+			s00_axi_aclk    => clk,
+			s00_axi_aresetn => aresetn,
+			s00_axi_awaddr  => awaddr,
+			s00_axi_awprot  => "000",
+			s00_axi_awvalid => awvalid,
+			s00_axi_awready => awready,
+			s00_axi_wdata   => wdata,
+			s00_axi_wstrb   => wstrb,
+			s00_axi_wvalid  => wvalid,
+			s00_axi_wready  => wready,
+			s00_axi_bresp   => bresp,
+			s00_axi_bvalid  => bvalid,
+			s00_axi_bready  => bready,
+			s00_axi_araddr  => araddr,
+			s00_axi_arprot  => "000",
+			s00_axi_arvalid => arvalid,
+			s00_axi_arready => arready,
+			s00_axi_rdata   => rdata,
+			s00_axi_rresp   => rresp,
+			s00_axi_rvalid  => rvalid,
+			s00_axi_rready  => rready
+		);
+
+	--! @brief Esegue le richieste del driver fino a COSIM_OP_END.
+	main : process
+
+		variable op    : integer;
+		variable n     : natural;
+		variable value : std_logic_vector(31 downto 0);
+		variable mask  : std_logic_vector(31 downto 0);
+
+		--! Scrittura AXI4-Lite, restituisce i cicli fino alla risposta accettata.
+		procedure axi_write(addr : natural; data : std_logic_vector(31 downto 0);
+		                    strb : std_logic_vector(3 downto 0); n : out natural) is
+			variable count : natural := 0;
+		begin
+			awaddr  <= std_logic_vector(to_unsigned(addr, awaddr'length));
+			wdata   <= data;
+			wstrb   <= strb;
+			awvalid <= '1';
+			wvalid  <= '1';
+			bready  <= '1';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when awready = '1' and wready = '1';
+			end loop;
+			awvalid <= '0';
+			wvalid  <= '0';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when bvalid = '1';
+			end loop;
+			bready <= '0';
+			n := count;
+		end procedure;
+
+		--! Lettura AXI4-Lite, restituisce il dato e i cicli fino al dato accettato.
+		procedure axi_read(addr : natural; data : out std_logic_vector(31 downto 0); n : out natural) is
+			variable count : natural := 0;
+		begin
+			araddr  <= std_logic_vector(to_unsigned(addr, araddr'length));
+			arvalid <= '1';
+			rready  <= '1';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when arready = '1';
+			end loop;
+			arvalid <= '0';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when rvalid = '1';
+			end loop;
+			data   := rdata;
+			rready <= '0';
+			n := count;
+		end procedure;
+
+		--! Attende n fronti di salita del clock.
+		procedure cycles_wait(n : natural) is
+		begin
+			for i in 1 to n loop
+				wait until rising_edge(clk);
+			end loop;
+		end procedure;
+
+		--! Conversioni tra integer del canale e vettori a 32 bit.
+		function to_slv(v : integer) return std_logic_vector is
+		begin
+			return std_logic_vector(to_signed(v, 32));
+		end function;
+
+		function to_int(v : std_logic_vector(31 downto 0)) return integer is
+		begin
+			return to_integer(signed(to_01(unsigned(v))));
+		end function;
+
+		--! Risponde con il livello di gpio_int stabile dopo l'ultimo fronte.
+		procedure reply(data : integer; cycles : natural) is
+		begin
+			wait for 1 ns;
+			if gpio_int = '1' then
+				ape_cosim_reply(data, cycles, 1);
+			else
+				ape_cosim_reply(data, cycles, 0);
+			end if;
+		end procedure;
+
+	begin
+		-- Reset ---------------------------------------------------------------
+		cycles_wait(4);
+		aresetn <= '1';
+		cycles_wait(2);
+
+		-- Richieste del driver ------------------------------------------------
+		loop
+			op := ape_cosim_recv;
+			case op is
+				when COSIM_OP_READ =>
+					axi_read(ape_cosim_offset, value, n);
+					reply(to_int(value), n);
+
+				when COSIM_OP_WRITE =>
+					mask := to_slv(ape_cosim_mask);
+					axi_write(ape_cosim_offset, to_slv(ape_cosim_value), mask(3 downto 0), n);
+					reply(0, n);
+
+				when COSIM_OP_PADS =>
+					mask  := to_slv(ape_cosim_mask);
+					value := to_slv(ape_cosim_value);
+					for i in 0 to WIDTH-1 loop
+						if mask(i) = '1' then
+							pad_drv(i) <= value(i);
+						end if;
+					end loop;
+					cycles_wait(PAD_CYCLES);
+					reply(0, PAD_CYCLES);
+
+				when COSIM_OP_IDLE =>
+					n := ape_cosim_value;
+					cycles_wait(n);
+					reply(0, n);
+
+				when others =>
+					reply(0, 0);
+					exit;
+			end case;
+		end loop;
+
+		done <= true;
+		wait;
+	end process;
+
+end sim;
+--! @}
+--! @}
@@ -0,0 +1,81 @@
+----------------------------------------------------------------------------------
+--! @file   APE_GPIO_cosim_pkg.vhd
+--  Company: Gruppo 5
+--! @author Alfonso, Pierluigi, Erasmo (APE)
+--!
+--! @date 19.10.2026
+--!
+--! @addtogroup APE_GPIO
+--! @{
+--! @addtogroup APE_GPIO_TB
+--! @{
+--!
+--! @brief Interfaccia VHPIDIRECT del testbench di co-simulazione.
+--!
+--! @details
+--!	I sottoprogrammi sono implementati in C in APE_GPIO_cosim_vhpi.c e collegati
+--!	all'eseguibile di simulazione in elaborazione; i corpi VHDL non sono mai
+--!	eseguiti. Le operazioni corrispondono alle COSIM_OP_xxx di
+--!	Driver/Driver_SIM/gpio_cosim_proto.h.
+----------------------------------------------------------------------------------
+
+package APE_GPIO_cosim_pkg is
+
+	constant COSIM_OP_READ  : integer := 0;	--! lettura AXI del registro offset
+	constant COSIM_OP_WRITE : integer := 1;	--! scrittura AXI di value, WSTRB = mask
+	constant COSIM_OP_PADS  : integer := 2;	--! i pad selezionati da mask assumono value
+	constant COSIM_OP_IDLE  : integer := 3;	--! attesa di value cicli di clock
+	constant COSIM_OP_END   : integer := 4;	--! fine della simulazione
+
+	--! Attende la richiesta successiva del driver e ne restituisce l'operazione.
+	impure function ape_cosim_recv return integer;
+	attribute foreign of ape_cosim_recv : function is "VHPIDIRECT ape_cosim_recv";
+
+	--! Campi dell'ultima richiesta.
+	impure function ape_cosim_offset return integer;
+	attribute foreign of ape_cosim_offset : function is "VHPIDIRECT ape_cosim_offset";
+	impure function ape_cosim_value return integer;
+	attribute foreign of ape_cosim_value : function is "VHPIDIRECT ape_cosim_value";
+	impure function ape_cosim_mask return integer;
+	attribute foreign of ape_cosim_mask : function is "VHPIDIRECT ape_cosim_mask";
+
+	--! Invia la risposta all'ultima richiesta.
+	procedure ape_cosim_reply(value : integer; cycles : integer; irq : integer);
+	attribute foreign of ape_cosim_reply : procedure is "VHPIDIRECT ape_cosim_reply";
+
+end APE_GPIO_cosim_pkg;
+
+package body APE_GPIO_cosim_pkg is
+
+	impure function ape_cosim_recv return integer is
+	begin
+		assert false report "VHPIDIRECT ape_cosim_recv" severity failure;
+		return COSIM_OP_END;
+	end function;
+
+	impure function ape_cosim_offset return integer is
+	begin
+		assert false report "VHPIDIRECT ape_cosim_offset" severity failure;
+		return 0;
+	end function;
+
+	impure function ape_cosim_value return integer is
+	begin
+		assert false report "VHPIDIRECT ape_cosim_value" severity failure;
+		return 0;
+	end function;
+
+	impure function ape_cosim_mask return integer is
+	begin
+		assert false report "VHPIDIRECT ape_cosim_mask" severity failure;
+		return 0;
+	end function;
+
+	procedure ape_cosim_reply(value : integer; cycles : integer; irq : integer) is
+	begin
+		assert false report "VHPIDIRECT ape_cosim_reply" severity failure;
+	end procedure;
+
+end APE_GPIO_cosim_pkg;
+--! @}
+--! @}
@@ -0,0 +1,105 @@
+/**
+  ******************************************************************************
+  * @file    APE_GPIO_cosim_vhpi.c
+  * @author  Alfonso,Pierluigi,Erasmo (APE)
+  * @version V1.0
+  * @date    19-Ottobre-2026
+  * @brief   Funzioni VHPIDIRECT del testbench di co-simulazione
+  * 		 APE_GPIO_cosim: ricevono le richieste del driver SIM e inviano le
+  * 		 risposte sul canale passato in APE_COSIM_FD.
+  *
+  *	@addtogroup APE_GPIO
+  * @{
+  * @addtogroup APE_GPIO_TB
+  * @{
+  * @brief   Le funzioni sono dichiarate in APE_GPIO_cosim_pkg.vhd con
+  * 		 l'attributo foreign. ape_cosim_recv blocca il simulatore fino alla
+  * 		 richiesta successiva: il tempo simulato avanza solo mentre il
+  * 		 testbench esegue la richiesta. I valori a 32 bit viaggiano come
+  * 		 integer VHDL con segno.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include "gpio_cosim_proto.h"
+
+/* Variabili -----------------------------------------------------------------*/
+static int cosim_fd = -1;		/*!< canale verso il driver*/
+static cosim_req_t cosim_req;	/*!< ultima richiesta ricevuta*/
+
+/**
+  * @brief  trasferisce un buffer completo sul canale
+  * @retval 0 in caso di successo, -1 altrimenti
+  */
+static int ape_cosim_xfer(void* buf,size_t len,int out){
+	char* p = buf;
+
+	while(len > 0){
+		ssize_t n = out ? write(cosim_fd,p,len) : read(cosim_fd,p,len);
+
+		if(n < 0 && errno == EINTR){
+			continue;
+		}
+		if(n <= 0){
+			return -1;
+		}
+		p += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/**
+  * @brief  attende la richiesta successiva del driver
+  * @retval l'operazione richiesta, COSIM_OP_END se il canale e' chiuso
+  */
+int32_t ape_cosim_recv(void){
+	if(cosim_fd < 0){
+		const char* env = getenv(COSIM_FD_ENV);
+
+		if(env == NULL){
+			fprintf(stderr,"APE_GPIO_cosim: %s non impostata\n",COSIM_FD_ENV);
+			return COSIM_OP_END;
+		}
+		cosim_fd = atoi(env);
+	}
+	if(ape_cosim_xfer(&cosim_req,sizeof(cosim_req),0) < 0){
+		return COSIM_OP_END;
+	}
+	return (int32_t)cosim_req.op;
+}
+
+/**
+  * @brief  campi dell'ultima richiesta
+  */
+int32_t ape_cosim_offset(void){
+	return (int32_t)cosim_req.offset;
+}
+
+int32_t ape_cosim_value(void){
+	return (int32_t)cosim_req.value;
+}
+
+int32_t ape_cosim_mask(void){
+	return (int32_t)cosim_req.mask;
+}
+
+/**
+  * @brief  invia la risposta all'ultima richiesta
+  * @param 	value: dato letto
+  * @param 	cycles: cicli di clock consumati
+  * @param 	irq: livello di gpio_int
+  */
+void ape_cosim_reply(int32_t value,int32_t cycles,int32_t irq){
+	cosim_rsp_t rsp = { (uint32_t)value, (uint32_t)cycles, (uint32_t)irq };
+
+	if(cosim_fd >= 0){
+		ape_cosim_xfer(&rsp,sizeof(rsp),1);
+	}
+}
+/**@}*/
+/**@}*/
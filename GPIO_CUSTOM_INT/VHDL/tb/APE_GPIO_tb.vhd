@@ -0,0 +1,468 @@
+----------------------------------------------------------------------------------
+--! @file   APE_GPIO_tb.vhd
+--  Company: Gruppo 5
+--! @author Alfonso, Pierluigi, Erasmo (APE)
+--!
+--! @date 19.10.2026
+--!
+--! @addtogroup APE_GPIO
+--! @{
+--! @addtogroup APE_GPIO_TB
+--! @{
+--!
+--! @brief Testbench di regressione della periferica APE_GPIO_TOP.
+--!
+--! @details
+--!	Il testbench pilota la periferica attraverso un modello funzionale del bus
+--!	AXI4-Lite (procedure <b>axi_write</b> e <b>axi_read</b>) e i pad attraverso due
+--!	driver risolti: <b>pad_drv</b>, usato dal process principale, e <b>pad_stim</b>,
+--!	usato dal process <b>edge_stim</b> per generare un fronte ad un numero di cicli
+--!	prefissato mentre il bus e' occupato.
+--!	La periferica e' istanziata con width = 8 e int_groups = 2 (pin 0-3 e 4-7).
+--!	Sono verificati:
+--!	- lettura e scrittura dei registri e strobe dei byte lane;
+--!	- DIR: i pin in uscita riportano DATA sul pad, i pin in ingresso il pad;
+--!	- rilevazione dei fronti di salita (IERR) e di discesa (IERF) e fronti disabilitati;
+--!	- DIR gating: un fronte su un pin in uscita non imposta ISR;
+--!	- ISR persistente, azzeramento selettivo tramite ICR e corsa tra un fronte e
+--!	  la scrittura di ICR sullo stesso pin, al variare del ciclo del fronte;
+--!	- gpio_int e gpio_int_group.
+--!	Al termine sono riportati i cicli di clock per scrittura e lettura, le
+--!	transazioni per ciclo su una sequenza di accessi consecutivi, la latenza in
+--!	cicli tra il fronte sul pad e gpio_int e tra la scrittura di ICR e la sua
+--!	disattivazione, il numero di verifiche per categoria e gli errori. La
+--!	simulazione termina con severity failure se almeno una verifica fallisce.
+--!	Lo script run_ghdl.sh analizza, elabora ed esegue il testbench con GHDL.
+----------------------------------------------------------------------------------
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity APE_GPIO_tb is
+end APE_GPIO_tb;
+
+architecture sim of APE_GPIO_tb is
+
+	constant WIDTH      : natural := 8;
+	constant GROUPS     : positive := 2;
+	constant CLK_PERIOD : time := 10 ns;
+
+	--! Offset dei registri.
+	constant DATA_REG   : natural := 16#00#;
+	constant DIR_REG    : natural := 16#04#;
+	constant IERR_REG   : natural := 16#08#;
+	constant IERF_REG   : natural := 16#0C#;
+	constant ICRISR_REG : natural := 16#10#;
+
+	signal clk     : std_logic := '0';
+	signal aresetn : std_logic := '0';
+	signal done    : boolean := false;
+
+	signal awaddr  : std_logic_vector(4 downto 0) := (others => '0');
+	signal awvalid : std_logic := '0';
+	signal awready : std_logic;
+	signal wdata   : std_logic_vector(31 downto 0) := (others => '0');
+	signal wstrb   : std_logic_vector(3 downto 0) := (others => '0');
+	signal wvalid  : std_logic := '0';
+	signal wready  : std_logic;
+	signal bresp   : std_logic_vector(1 downto 0);
+	signal bvalid  : std_logic;
+	signal bready  : std_logic := '0';
+	signal araddr  : std_logic_vector(4 downto 0) := (others => '0');
+	signal arvalid : std_logic := '0';
+	signal arready : std_logic;
+	signal rdata   : std_logic_vector(31 downto 0);
+	signal rresp   : std_logic_vector(1 downto 0);
+	signal rvalid  : std_logic;
+	signal rready  : std_logic := '0';
+
+	signal pad            : std_logic_vector(WIDTH-1 downto 0);
+	signal pad_drv        : std_logic_vector(WIDTH-1 downto 0) := (others => 'Z');
+	signal pad_stim       : std_logic_vector(WIDTH-1 downto 0) := (others => 'Z');
+	signal gpio_int       : std_logic;
+	signal gpio_int_group : std_logic_vector(GROUPS-1 downto 0);
+
+	--! Richiesta al process edge_stim: dopo stim_delay fronti di salita del clock
+	--! porta il pin stim_pin al valore stim_value.
+	signal stim_req   : boolean := false;
+	signal stim_pin   : natural := 0;
+	signal stim_value : std_logic := '0';
+	signal stim_delay : natural := 0;
+
+begin
+
+	clk <= not clk after CLK_PERIOD/2 when not done else '0';
+
+	pad <= pad_drv;
+	pad <= pad_stim;
+
+	dut : entity work.APE_GPIO_TOP
+		generic map (
+			width      => WIDTH,
+			int_groups => GROUPS
+		)
+		port map (
+			pad             => pad,
+			gpio_int        => gpio_int,
+			gpio_int_group  => gpio_int_group,
+			s00_axi_aclk    => clk,
+			s00_axi_aresetn => aresetn,
+			s00_axi_awaddr  => awaddr,
+			s00_axi_awprot  => "000",
+			s00_axi_awvalid => awvalid,
+			s00_axi_awready => awready,
+			s00_axi_wdata   => wdata,
+			s00_axi_wstrb   => wstrb,
+			s00_axi_wvalid  => wvalid,
+			s00_axi_wready  => wready,
+			s00_axi_bresp   => bresp,
+			s00_axi_bvalid  => bvalid,
+			s00_axi_bready  => bready,
+			s00_axi_araddr  => araddr,
+			s00_axi_arprot  => "000",
+			s00_axi_arvalid => arvalid,
+			s00_axi_arready => arready,
+			s00_axi_rdata   => rdata,
+			s00_axi_rresp   => rresp,
+			s00_axi_rvalid  => rvalid,
+			s00_axi_rready  => rready
+		);
+
+	--! @brief Genera un fronte sul pad dopo un numero prefissato di cicli dalla richiesta.
+	edge_stim : process
+	begin
+		wait on stim_req;
+		for i in 1 to stim_delay loop
+			wait until rising_edge(clk);
+		end loop;
+		pad_stim(stim_pin) <= stim_value;
+	end process;
+
+	--! @brief Sequenza di verifica.
+	main : process
+
+		variable errors      : natural := 0;
+		variable cov_rw      : natural := 0;
+		variable cov_rise    : natural := 0;
+		variable cov_fall    : natural := 0;
+		variable cov_dir     : natural := 0;
+		variable cov_icr     : natural := 0;
+		variable cov_int     : natural := 0;
+		variable wr_cycles   : natural := 0;
+		variable rd_cycles   : natural := 0;
+		variable cycles      : natural := 0;
+		variable int_latency : natural := 0;
+		variable icr_latency : natural := 0;
+		variable race_lost   : natural := 0;
+		variable value       : std_logic_vector(31 downto 0);
+
+		--! Verifica una condizione e conta gli errori.
+		procedure check(cond : boolean; msg : string; cov : inout natural) is
+		begin
+			cov := cov + 1;
+			if not cond then
+				errors := errors + 1;
+				report "ERRORE: " & msg severity error;
+			end if;
+		end procedure;
+
+		--! Scrittura AXI4-Lite: indirizzo e dato sono presentati insieme, come dal
+		--! driver del processore. Restituisce i cicli dal primo fronte di clock alla
+		--! risposta accettata.
+		procedure axi_write(addr : natural; data : std_logic_vector(31 downto 0);
+		                    strb : std_logic_vector(3 downto 0); n : out natural) is
+			variable count : natural := 0;
+		begin
+			awaddr  <= std_logic_vector(to_unsigned(addr, awaddr'length));
+			wdata   <= data;
+			wstrb   <= strb;
+			awvalid <= '1';
+			wvalid  <= '1';
+			bready  <= '1';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when awready = '1' and wready = '1';
+			end loop;
+			awvalid <= '0';
+			wvalid  <= '0';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when bvalid = '1';
+			end loop;
+			bready <= '0';
+			n := count;
+		end procedure;
+
+		procedure axi_write(addr : natural; data : std_logic_vector(31 downto 0)) is
+			variable n : natural;
+		begin
+			axi_write(addr, data, "1111", n);
+		end procedure;
+
+		--! Lettura AXI4-Lite. Restituisce il dato e i cicli dal primo fronte di
+		--! clock al dato accettato.
+		procedure axi_read(addr : natural; data : out std_logic_vector(31 downto 0); n : out natural) is
+			variable count : natural := 0;
+		begin
+			araddr  <= std_logic_vector(to_unsigned(addr, araddr'length));
+			arvalid <= '1';
+			rready  <= '1';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when arready = '1';
+			end loop;
+			arvalid <= '0';
+			loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				exit when rvalid = '1';
+			end loop;
+			data   := rdata;
+			rready <= '0';
+			n := count;
+		end procedure;
+
+		procedure axi_read(addr : natural; data : out std_logic_vector(31 downto 0)) is
+			variable n : natural;
+		begin
+			axi_read(addr, data, n);
+		end procedure;
+
+		--! Attende n fronti di salita del clock.
+		procedure cycles_wait(n : natural) is
+		begin
+			for i in 1 to n loop
+				wait until rising_edge(clk);
+			end loop;
+		end procedure;
+
+		--! Porta un pin del pad al valore indicato e attende che il fronte sia
+		--! rilevato; restituisce i cicli fino a gpio_int alto (0 se non si alza).
+		procedure drive_pin(pin : natural; v : std_logic; latency : out natural) is
+			variable count : natural := 0;
+		begin
+			pad_drv(pin) <= v;
+			latency := 0;
+			for i in 1 to 8 loop
+				wait until rising_edge(clk);
+				count := count + 1;
+				wait for 1 ns;
+				if gpio_int = '1' then
+					latency := count;
+					exit;
+				end if;
+			end loop;
+			cycles_wait(2);
+		end procedure;
+
+		function hex(v : std_logic_vector) return string is
+		begin
+			return to_hstring(v);
+		end function;
+
+		--! Richiede al process edge_stim di portare il pin al valore indicato dopo
+		--! delay fronti di salita del clock.
+		procedure stim(pin : natural; v : std_logic; delay : natural) is
+		begin
+			stim_pin   <= pin;
+			stim_value <= v;
+			stim_delay <= delay;
+			stim_req   <= not stim_req;
+		end procedure;
+
+		variable lat   : natural;
+		variable first : integer;
+
+	begin
+		-- Reset ---------------------------------------------------------------
+		-- Pin 0,1,4,5 pilotati dal testbench, pin 2,3,6,7 dalla periferica
+		pad_drv <= "ZZ01ZZ10";
+		cycles_wait(4);
+		aresetn <= '1';
+		cycles_wait(2);
+
+		-- Lettura e scrittura dei registri ------------------------------------
+		axi_write(DIR_REG, x"00000033", "1111", wr_cycles);
+		axi_read(DIR_REG, value, rd_cycles);
+		check(value = x"00000033", "DIR letto " & hex(value), cov_rw);
+		axi_write(IERR_REG, x"A5A55A5A");
+		axi_read(IERR_REG, value);
+		check(value = x"A5A55A5A", "IERR letto " & hex(value), cov_rw);
+		axi_write(IERF_REG, x"5A5AA5A5");
+		axi_read(IERF_REG, value);
+		check(value = x"5A5AA5A5", "IERF letto " & hex(value), cov_rw);
+
+		-- Strobe dei byte lane: solo il byte 1 di IERR cambia
+		axi_write(IERR_REG, x"FFFFFFFF", "0010", lat);
+		axi_read(IERR_REG, value);
+		check(value = x"A5A5FF5A", "IERR con WSTRB=0010 " & hex(value), cov_rw);
+		axi_write(IERR_REG, x"00000000");
+		axi_write(IERF_REG, x"00000000");
+		axi_write(ICRISR_REG, x"000000FF");
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000000", "ISR dopo il reset " & hex(value), cov_icr);
+
+		-- DIR: pin 0,1,4,5 in ingresso, pin 2,3,6,7 in uscita ------------------
+		axi_write(DATA_REG, x"000000CC");
+		cycles_wait(2);
+		axi_read(DATA_REG, value);
+		check(value(WIDTH-1 downto 0) = x"DE", "DATA con DIR=33 " & hex(value), cov_dir);
+		check(pad(7 downto 6) = "11" and pad(3 downto 2) = "11", "pad in uscita", cov_dir);
+
+		-- Fronti di salita e discesa ------------------------------------------
+		axi_write(IERR_REG, x"00000001");
+		axi_write(IERF_REG, x"00000002");
+
+		drive_pin(0, '1', int_latency);
+		check(int_latency > 0, "fronte di salita su pin 0 senza gpio_int", cov_rise);
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000001", "ISR dopo fronte di salita " & hex(value), cov_rise);
+		check(gpio_int_group = "01", "gpio_int_group dopo pin 0", cov_int);
+
+		drive_pin(1, '0', lat);
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000003", "ISR dopo fronte di discesa " & hex(value), cov_fall);
+
+		-- ISR persistente e azzeramento selettivo ------------------------------
+		cycles_wait(10);
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000003", "ISR non persistente " & hex(value), cov_icr);
+		axi_write(ICRISR_REG, x"00000002");
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000001", "ICR=2 " & hex(value), cov_icr);
+		check(gpio_int = '1', "gpio_int con ISR=1", cov_int);
+
+		-- Latenza dalla scrittura di ICR alla disattivazione di gpio_int
+		awaddr  <= std_logic_vector(to_unsigned(ICRISR_REG, awaddr'length));
+		wdata   <= x"00000001";
+		wstrb   <= "1111";
+		awvalid <= '1';
+		wvalid  <= '1';
+		bready  <= '1';
+		icr_latency := 0;
+		loop
+			wait until rising_edge(clk);
+			icr_latency := icr_latency + 1;
+			if awready = '1' and wready = '1' then
+				awvalid <= '0';
+				wvalid  <= '0';
+			end if;
+			wait for 1 ns;
+			exit when gpio_int = '0' or icr_latency = 16;
+		end loop;
+		check(gpio_int = '0', "gpio_int alto dopo ICR", cov_int);
+		cycles_wait(2);
+		bready <= '0';
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000000", "ISR dopo ICR=1 " & hex(value), cov_icr);
+
+		-- Fronti non abilitati: discesa su pin 0, salita su pin 1
+		drive_pin(0, '0', lat);
+		check(lat = 0, "fronte di discesa non abilitato su pin 0", cov_fall);
+		drive_pin(1, '1', lat);
+		check(lat = 0, "fronte di salita non abilitato su pin 1", cov_rise);
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000000", "ISR dopo fronti non abilitati " & hex(value), cov_rise);
+
+		-- DIR gating: fronti su pin in uscita non impostano ISR ---------------
+		axi_write(IERR_REG, x"000000C0");
+		axi_write(IERF_REG, x"000000C0");
+		axi_write(DATA_REG, x"0000000C");
+		axi_write(DATA_REG, x"000000CC");
+		cycles_wait(4);
+		axi_read(ICRISR_REG, value);
+		check(value = x"00000000", "fronte su pin in uscita " & hex(value), cov_dir);
+		check(gpio_int = '0', "gpio_int per pin in uscita", cov_dir);
+
+		-- Stesso pin in ingresso: il fronte e' rilevato sul gruppo 1
+		pad_drv(7 downto 6) <= "11";
+		axi_write(DIR_REG, x"000000F3");
+		cycles_wait(2);
+		drive_pin(7, '0', lat);
+		check(lat > 0, "fronte su pin 7 in ingresso", cov_dir);
+		check(gpio_int_group = "10", "gpio_int_group dopo pin 7", cov_int);
+		axi_write(ICRISR_REG, x"00000080");
+		axi_write(IERF_REG, x"00000000");
+
+		-- Corsa tra fronte e ICR -----------------------------------------------
+		-- Con ISR(4)=1 la scrittura di ICR su pin 4 e' avviata insieme ad un
+		-- fronte di salita che arriva d cicli dopo. Un fronte che precede
+		-- l'azzeramento si fonde con il bit pendente e viene azzerato con esso,
+		-- uno successivo deve restare in ISR: il risultato deve essere monotono
+		-- in d e l'ultimo fronte deve essere rilevato.
+		axi_write(IERR_REG, x"00000010");
+		pad_drv(4) <= 'Z';
+		stim(4, '1', 0);
+		cycles_wait(3);
+		first := -1;
+		for d in 0 to 6 loop
+			stim(4, '0', 0);
+			cycles_wait(3);
+			stim(4, '1', 0);
+			cycles_wait(3);
+			stim(4, '0', 0);
+			cycles_wait(3);
+			axi_read(ICRISR_REG, value);
+			check(value(4) = '1', "ISR(4) prima della corsa, d=" & integer'image(d), cov_icr);
+
+			stim(4, '1', d);
+			axi_write(ICRISR_REG, x"00000010");
+			cycles_wait(8);
+			axi_read(ICRISR_REG, value);
+			if value(4) = '0' then
+				race_lost := race_lost + 1;
+				check(first < 0, "fronte perso dopo un fronte rilevato, d=" & integer'image(d), cov_icr);
+			elsif first < 0 then
+				first := d;
+			end if;
+			axi_write(ICRISR_REG, x"00000010");
+		end loop;
+		check(first >= 0, "nessun fronte rilevato nella corsa con ICR", cov_icr);
+		axi_write(IERR_REG, x"00000000");
+		axi_write(ICRISR_REG, x"000000FF");
+
+		-- Throughput: accessi consecutivi ---------------------------------------
+		cycles := 0;
+		for i in 0 to 63 loop
+			axi_write(IERF_REG, std_logic_vector(to_unsigned(i, 32)), "1111", lat);
+			cycles := cycles + lat;
+		end loop;
+		report "scritture consecutive: 64 in " & integer'image(cycles) & " cicli, " &
+		       real'image(64.0 / real(cycles)) & " transazioni/ciclo";
+		cycles := 0;
+		for i in 0 to 63 loop
+			axi_read(IERF_REG, value, lat);
+			cycles := cycles + lat;
+		end loop;
+		report "letture consecutive: 64 in " & integer'image(cycles) & " cicli, " &
+		       real'image(64.0 / real(cycles)) & " transazioni/ciclo";
+		check(value = x"0000003F", "IERF dopo le scritture consecutive " & hex(value), cov_rw);
+
+		-- Riepilogo -----------------------------------------------------------
+		report "cicli per scrittura: " & integer'image(wr_cycles) &
+		       ", per lettura: " & integer'image(rd_cycles);
+		report "latenza fronte -> gpio_int: " & integer'image(int_latency) & " cicli" &
+		       ", scrittura ICR -> gpio_int basso: " & integer'image(icr_latency) & " cicli";
+		report "corsa con ICR: fronti assorbiti " & integer'image(race_lost) &
+		       " su 7, primo fronte rilevato a " & integer'image(first) & " cicli dalla scrittura";
+		report "verifiche: registri " & integer'image(cov_rw) &
+		       ", salita " & integer'image(cov_rise) &
+		       ", discesa " & integer'image(cov_fall) &
+		       ", DIR " & integer'image(cov_dir) &
+		       ", ICR/ISR " & integer'image(cov_icr) &
+		       ", interrupt " & integer'image(cov_int);
+		assert errors = 0
+			report "errori: " & integer'image(errors) severity failure;
+		report "nessun errore";
+
+		done <= true;
+		wait;
+	end process;
+
+end sim;
+--! @}
+--! @}
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Elabora il testbench di co-simulazione APE_GPIO_cosim con la libreria
+# VHPIDIRECT APE_GPIO_cosim_vhpi.c. L'eseguibile prodotto viene avviato dal
+# driver SIM (Driver_SIM/gpio_cosim.c), non va eseguito da solo.
+# Uso: ./build_cosim.sh <eseguibile>
+# Richiede GHDL con backend LLVM o GCC (il backend mcode non collega
+# oggetti esterni in elaborazione).
+set -e
+
+GHDL=${GHDL:-ghdl}
+CC=${CC:-cc}
+FLAGS="--std=08"
+DIR=$(cd "$(dirname "$0")" && pwd)
+OUT=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+cd "$WORK"
+$CC -c -O2 -I"$DIR/../../Driver/Driver_SIM" -o cosim_vhpi.o "$DIR/APE_GPIO_cosim_vhpi.c"
+$GHDL -a $FLAGS \
+	"$DIR/../gpio_pad.vhd" \
+	"$DIR/../gpio_array.vhd" \
+	"$DIR/../edge_detector.vhd" \
+	"$DIR/../APE_GPIO_AXI.vhd" \
+	"$DIR/../APE_GPIO_TOP.vhd" \
+	"$DIR/APE_GPIO_cosim_pkg.vhd" \
+	"$DIR/APE_GPIO_cosim.vhd"
+$GHDL -e $FLAGS -Wl,cosim_vhpi.o -o "$OUT" APE_GPIO_cosim
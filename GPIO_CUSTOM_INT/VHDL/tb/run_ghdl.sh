@@ -0,0 +1,22 @@
+#!/bin/sh
+# Analizza, elabora ed esegue il testbench APE_GPIO_tb con GHDL.
+# Uso: ./run_ghdl.sh [opzioni di simulazione, es. --wave=APE_GPIO_tb.ghw]
+# Restituisce un codice diverso da 0 se una verifica fallisce.
+set -e
+
+GHDL=${GHDL:-ghdl}
+FLAGS="--std=08"
+DIR=$(cd "$(dirname "$0")" && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+cd "$WORK"
+$GHDL -a $FLAGS \
+	"$DIR/../gpio_pad.vhd" \
+	"$DIR/../gpio_array.vhd" \
+	"$DIR/../edge_detector.vhd" \
+	"$DIR/../APE_GPIO_AXI.vhd" \
+	"$DIR/../APE_GPIO_TOP.vhd" \
+	"$DIR/APE_GPIO_tb.vhd"
+$GHDL -e $FLAGS APE_GPIO_tb
+$GHDL -r $FLAGS APE_GPIO_tb "$@"